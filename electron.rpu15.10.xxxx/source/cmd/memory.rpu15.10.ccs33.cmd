@@ -46,6 +46,7 @@ SECTIONS
   .special   : {
                  "./Debug/driver.Adc.obj"         (.text)
                  "./Debug/driver.Adc.ll.obj"      (.text)
+                 "./Debug/driver.Capture.obj"     (.text)
                  "./Debug/driver.FullBridge.obj"  (.text)
                  "./Debug/driver.Interrupt.obj"   (.text)
                  "./Debug/driver.Pll.obj"         (.text)
@@ -46,6 +46,7 @@ SECTIONS
   .special   : {
                  "driver.Adc.obj"         (.text)
                  "driver.Adc.ll.obj"      (.text)
+                 "driver.Capture.obj"     (.text)
                  "driver.FullBridge.obj"  (.text)
                  "driver.Interrupt.obj"   (.text)
                  "driver.Pll.obj"         (.text)
@@ -0,0 +1,530 @@
+/**
+ * Lossless compression of Analog-to-Digital Converter results.
+ *
+ * The compressor packs full blocks of an ADC task into a log buffer of 16-bit words.
+ * Each sample is predicted by the previous sample of the same lane, and the difference
+ * is coded by an adaptive Rice code. The log buffer always contains a decodable stream,
+ * thus it might be dumped at any moment and decoded by the decompressor on a host.
+ *
+ * The log buffer format:
+ * word 0      - the lanes number;
+ * word 1      - the low half of the samples number;
+ * word 2      - the high half of the samples number;
+ * word 3...   - the Rice coded stream, MSB first.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_ADC_COMPRESSOR_HPP_
+#define DRIVER_ADC_COMPRESSOR_HPP_
+
+#include "driver.Adc.hpp"
+
+class AdcCodec
+{
+
+public:
+
+  /**
+   * Error defenition.
+   */
+  static const int32 ERROR = -1;
+
+  /**
+   * Max number of interleaved signals in a block.
+   */
+  static const int32 MAX_LANES = 32;
+
+  /**
+   * Number of the log buffer header words.
+   */
+  static const int32 HEADER_LENGTH = 3;
+
+protected:
+
+  /**
+   * A prediction lane of a signal.
+   */
+  struct Lane
+  {
+    /**
+     * The previous sample of the signal.
+     */
+    int32 prev;
+
+    /**
+     * The accumulated magnitude of the coded values.
+     */
+    uint32 sum;
+
+    /**
+     * The number of the accumulated values.
+     */
+    uint32 num;
+  };
+
+  /**
+   * Constructor.
+   */
+  AdcCodec() :
+    lanes_ (0){
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~AdcCodec(){}
+
+  /**
+   * Resets the prediction lanes.
+   */
+  void resetLanes()
+  {
+    for(int32 i=0; i<MAX_LANES; i++)
+    {
+      lane_[i].prev = SAMPLE_SEED;
+      lane_[i].sum = SUM_SEED;
+      lane_[i].num = 1;
+    }
+  }
+
+  /**
+   * Returns the Rice parameter of a lane.
+   *
+   * @param lane a prediction lane.
+   * @return the parameter value.
+   */
+  static int32 parameter(const Lane& lane)
+  {
+    int32 k = 0;
+    while((lane.num << k) < lane.sum && k < MAX_PARAMETER) k++;
+    return k;
+  }
+
+  /**
+   * Updates the adaptive state of a lane.
+   *
+   * @param lane   a prediction lane.
+   * @param sample a new sample.
+   * @param value  the coded value of the sample.
+   */
+  static void update(Lane& lane, int32 sample, uint32 value)
+  {
+    lane.prev = sample;
+    lane.sum += value;
+    if(++lane.num < RESET_NUMBER) return;
+    lane.sum >>= 1;
+    lane.num >>= 1;
+  }
+
+  /**
+   * Number of unary bits after which a value is escaped in 16 raw bits.
+   */
+  static const int32 ESCAPE_LIMIT = 16;
+
+  /**
+   * Max Rice parameter.
+   */
+  static const int32 MAX_PARAMETER = 15;
+
+  /**
+   * Number of values after which a lane statistic is halved.
+   */
+  static const uint32 RESET_NUMBER = 64;
+
+  /**
+   * The initial accumulated magnitude.
+   */
+  static const uint32 SUM_SEED = 4;
+
+  /**
+   * The initial sample value of 12-bit ADC result middle scale.
+   */
+  static const int32 SAMPLE_SEED = 0x0800;
+
+  /**
+   * The number of interleaved signals in a block.
+   */
+  int32 lanes_;
+
+  /**
+   * The prediction lanes.
+   */
+  Lane lane_[MAX_LANES];
+
+};
+
+class AdcCompressor : public AdcCodec
+{
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param buffer a log buffer.
+   * @param length the log buffer length in 16-bit words.
+   * @param lanes  a number of interleaved signals in a block, which
+   *               usually equals channels number multiplied by results number.
+   */
+  AdcCompressor(uint16* buffer, int32 length, int32 lanes) : AdcCodec(),
+    buffer_  (buffer),
+    length_  (length),
+    index_   (HEADER_LENGTH),
+    samples_ (0),
+    acc_     (0),
+    bits_    (0){
+    lanes_ = lanes;
+    reset();
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~AdcCompressor(){}
+
+  /**
+   * Tests if this object has been constructed.
+   *
+   * @return true if object has been constructed successfully.
+   */
+  bool isConstructed() const
+  {
+    if(buffer_ == NULL || length_ <= HEADER_LENGTH) return false;
+    return 0 < lanes_ && lanes_ <= MAX_LANES;
+  }
+
+  /**
+   * Compresses the first full block of an ADC task into the log buffer.
+   *
+   * The method does not free the compressed block,
+   * thus the block has to be freed by a caller.
+   *
+   * @param task an ADC task.
+   * @return true if the block has been compressed, or false if no full block or no space in the log.
+   */
+  bool compress(const Adc::TaskInterface& task)
+  {
+    if( not isConstructed() ) return false;
+    const int32* block = task.getFull();
+    if(block == NULL) return false;
+    int32 number = task.getSequencesNumber() * task.getChannelsNumber() * task.getResultsNumber();
+    if(number % lanes_ != 0) return false;
+    // Test the worst case of an escaped value per each sample
+    if(length_ - index_ <= number * 2) return false;
+    int32 lane = 0;
+    for(int32 i=0; i<number; i++)
+    {
+      encode(lane_[lane], block[i]);
+      if(++lane == lanes_) lane = 0;
+    }
+    // Keep the partial word in the log, thus the log is decodable at any moment
+    if(bits_ > 0) buffer_[index_] = static_cast<uint16>(acc_ << (16 - bits_)) & 0xffff;
+    samples_ += number;
+    buffer_[1] = static_cast<uint16>(samples_) & 0xffff;
+    buffer_[2] = static_cast<uint16>(samples_ >> 16) & 0xffff;
+    return true;
+  }
+
+  /**
+   * Resets the log buffer.
+   */
+  void reset()
+  {
+    resetLanes();
+    index_ = HEADER_LENGTH;
+    samples_ = 0;
+    acc_ = 0;
+    bits_ = 0;
+    if( not isConstructed() ) return;
+    buffer_[0] = static_cast<uint16>(lanes_);
+    buffer_[1] = 0;
+    buffer_[2] = 0;
+  }
+
+  /**
+   * Returns the number of compressed samples.
+   *
+   * @return the samples number.
+   */
+  int32 getSamplesNumber() const
+  {
+    return samples_;
+  }
+
+  /**
+   * Returns the used length of the log buffer.
+   *
+   * @return the number of used 16-bit words including the header.
+   */
+  int32 getLength() const
+  {
+    return bits_ > 0 ? index_ + 1 : index_;
+  }
+
+private:
+
+  /**
+   * Encodes a sample.
+   *
+   * @param lane   a prediction lane of the sample.
+   * @param sample a sample.
+   */
+  void encode(Lane& lane, int32 sample)
+  {
+    // Wrap the prediction error into 16 bits and map it to the unsigned value
+    int32 diff = ((sample - lane.prev + 0x8000) & 0xffff) - 0x8000;
+    uint32 value = diff >= 0 ? static_cast<uint32>(diff) << 1 : (static_cast<uint32>(-diff) << 1) - 1;
+    int32 k = parameter(lane);
+    uint32 q = value >> k;
+    if(q < ESCAPE_LIMIT)
+    {
+      put(0xffff, static_cast<int32>(q));
+      put(0x0000, 1);
+      put(value, k);
+    }
+    else
+    {
+      put(0xffff, ESCAPE_LIMIT);
+      put(value, 16);
+    }
+    update(lane, sample & 0xffff, value);
+  }
+
+  /**
+   * Puts bits into the log stream.
+   *
+   * @param value a value, which low bits will be put.
+   * @param count a number of the bits from 0 to 16.
+   */
+  void put(uint32 value, int32 count)
+  {
+    if(count == 0) return;
+    acc_ = acc_ << count | (value & 0xffffffff >> (32 - count));
+    bits_ += count;
+    if(bits_ < 16) return;
+    bits_ -= 16;
+    buffer_[index_++] = static_cast<uint16>(acc_ >> bits_) & 0xffff;
+    acc_ &= (static_cast<uint32>(1) << bits_) - 1;
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  AdcCompressor(const AdcCompressor& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  AdcCompressor& operator =(const AdcCompressor& obj);
+
+  /**
+   * The log buffer.
+   */
+  uint16* buffer_;
+
+  /**
+   * The log buffer length in words.
+   */
+  int32 length_;
+
+  /**
+   * The index of the current word of the log buffer.
+   */
+  int32 index_;
+
+  /**
+   * The number of compressed samples.
+   */
+  int32 samples_;
+
+  /**
+   * The bits accumulator.
+   */
+  uint32 acc_;
+
+  /**
+   * The number of bits in the accumulator.
+   */
+  int32 bits_;
+
+};
+
+/**
+ * The class uses types of a target only, thus it might be built on a host for decoding logs.
+ */
+class AdcDecompressor : public AdcCodec
+{
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param buffer a log buffer.
+   * @param length the log buffer length in 16-bit words.
+   */
+  AdcDecompressor(const uint16* buffer, int32 length) : AdcCodec(),
+    buffer_  (buffer),
+    length_  (length),
+    index_   (HEADER_LENGTH),
+    samples_ (0),
+    left_    (0),
+    current_ (0),
+    bit_     (0){
+    resetLanes();
+    if(buffer_ == NULL || length_ <= HEADER_LENGTH) return;
+    lanes_ = buffer_[0] & 0xffff;
+    samples_ = (buffer_[1] & 0xffff) | static_cast<int32>(buffer_[2] & 0xffff) << 16;
+    left_ = samples_;
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~AdcDecompressor(){}
+
+  /**
+   * Tests if this object has been constructed.
+   *
+   * @return true if object has been constructed successfully.
+   */
+  bool isConstructed() const
+  {
+    return 0 < lanes_ && lanes_ <= MAX_LANES;
+  }
+
+  /**
+   * Returns the number of interleaved signals.
+   *
+   * @return the lanes number.
+   */
+  int32 getLanesNumber() const
+  {
+    return lanes_;
+  }
+
+  /**
+   * Returns the number of compressed samples.
+   *
+   * @return the samples number.
+   */
+  int32 getSamplesNumber() const
+  {
+    return samples_;
+  }
+
+  /**
+   * Decodes next sample.
+   *
+   * @return the sample, or ERROR if no samples are left or the log is corrupted.
+   */
+  int32 read()
+  {
+    if( not isConstructed() || left_ == 0 ) return ERROR;
+    Lane& lane = lane_[current_];
+    int32 k = parameter(lane);
+    uint32 q = 0;
+    int32 bit;
+    while( (bit = get(1)) == 1 && q < ESCAPE_LIMIT ) q++;
+    uint32 value;
+    if(q < ESCAPE_LIMIT)
+    {
+      if(bit == ERROR) return ERROR;
+      int32 rem = get(k);
+      if(rem == ERROR) return ERROR;
+      value = q << k | static_cast<uint32>(rem);
+    }
+    else
+    {
+      // The escape read one bit of the raw value already
+      int32 raw = get(15);
+      if(bit == ERROR || raw == ERROR) return ERROR;
+      value = static_cast<uint32>(bit) << 15 | static_cast<uint32>(raw);
+    }
+    int32 diff = (value & 0x1) == 0 ? static_cast<int32>(value >> 1) : -static_cast<int32>((value + 1) >> 1);
+    int32 sample = (lane.prev + diff) & 0xffff;
+    update(lane, sample, value);
+    if(++current_ == lanes_) current_ = 0;
+    left_--;
+    return sample;
+  }
+
+private:
+
+  /**
+   * Gets bits from the log stream.
+   *
+   * @param count a number of the bits from 0 to 16.
+   * @return the bits value, or ERROR if the stream is over.
+   */
+  int32 get(int32 count)
+  {
+    int32 value = 0;
+    for(int32 i=0; i<count; i++)
+    {
+      if(index_ >= length_) return ERROR;
+      value = value << 1 | (buffer_[index_] >> (15 - bit_) & 0x1);
+      if(++bit_ < 16) continue;
+      bit_ = 0;
+      index_++;
+    }
+    return value;
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  AdcDecompressor(const AdcDecompressor& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  AdcDecompressor& operator =(const AdcDecompressor& obj);
+
+  /**
+   * The log buffer.
+   */
+  const uint16* buffer_;
+
+  /**
+   * The log buffer length in words.
+   */
+  int32 length_;
+
+  /**
+   * The index of the current word of the log buffer.
+   */
+  int32 index_;
+
+  /**
+   * The number of compressed samples.
+   */
+  int32 samples_;
+
+  /**
+   * The number of samples left for decoding.
+   */
+  int32 left_;
+
+  /**
+   * The index of current lane.
+   */
+  int32 current_;
+
+  /**
+   * The index of current bit in the current word.
+   */
+  int32 bit_;
+
+};
+#endif // DRIVER_ADC_COMPRESSOR_HPP_
@@ -0,0 +1,200 @@
+/**
+ * Enhanced Capture driver factory.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_CAPTURE_HPP_
+#define DRIVER_CAPTURE_HPP_
+
+#include "driver.Types.hpp"
+#include "driver.Pwm.hpp"
+
+class Capture
+{
+
+public:
+
+  /**
+   * Error defenition.
+   */
+  static const int32 ERROR = -1;
+
+  /**
+   * A measured period of a signal.
+   *
+   * The times are counted by the time-stamp counter,
+   * which is clocked by the CPU clock.
+   */
+  struct Sample
+  {
+    /**
+     * The time between two rising edges in CPU clocks.
+     */
+    uint32 period;
+
+    /**
+     * The time between a rising edge and next falling edge in CPU clocks.
+     */
+    uint32 width;
+
+  };
+
+  /**
+   * Destructor.
+   */
+  virtual ~Capture(){}
+
+  /**
+   * Starts capturing the edges of the signal.
+   *
+   * The module timestamps two rising and two falling edges in one-shot mode, and
+   * its interrupt service routine puts the measured period to the ring buffer
+   * and re-arms the module for next four edges. Thus, the interrupt rate
+   * is no more than half of the signal frequency.
+   *
+   * @return true if capturing has been started successfully.
+   */
+  virtual bool start() = 0;
+
+  /**
+   * Stops capturing.
+   */
+  virtual void stop() = 0;
+
+  /**
+   * Reads the oldest measured period from the ring buffer.
+   *
+   * @param sample a period to be filled.
+   * @return true if the period has been read, or false if the buffer is empty.
+   */
+  virtual bool read(Sample& sample) = 0;
+
+  /**
+   * Returns a number of the measured periods in the ring buffer.
+   *
+   * @return the number of periods, or ERROR if error has been occurred.
+   */
+  virtual int32 getSamplesNumber() const = 0;
+
+  /**
+   * Returns a number of the measured periods, which have been lost as the buffer was full.
+   *
+   * @return the number of periods, or ERROR if error has been occurred.
+   */
+  virtual int32 getLostNumber() const = 0;
+
+  /**
+   * Returns the last measured period.
+   *
+   * @param sample a period to be filled.
+   * @return true if a period has been measured.
+   */
+  virtual bool getLast(Sample& sample) const = 0;
+
+  /**
+   * Returns the signal frequency of the last measured period.
+   *
+   * @return the frequency in Hz, or ERROR if no period has been measured.
+   */
+  virtual float32 getFrequency() const = 0;
+
+  /**
+   * Returns the signal duty of the last measured period.
+   *
+   * @return the duty in percentages, or ERROR if no period has been measured.
+   */
+  virtual float32 getDuty() const = 0;
+
+  /**
+   * Returns the dead-band time between the signal and its complementary signal.
+   *
+   * Both signals have the same period, and the time, when both of them are low,
+   * is split equally between the rising and falling edges delays.
+   * The last measured periods of both modules are used.
+   *
+   * @param complement a module capturing the complementary signal.
+   * @return the dead-band time in ns, or ERROR if error has been occurred.
+   */
+  virtual float32 getDeadTime(const ::Capture& complement) const = 0;
+
+  /**
+   * Returns the time-stamp counter clock frequency.
+   *
+   * @return the clock frequency in Hz, or ERROR if error has been occurred.
+   */
+  virtual int32 getClockFrequency() const = 0;
+
+  /**
+   * Sets a PWM module channel which generates the captured signal.
+   *
+   * The interrupt service routine continuously compares each measured period
+   * with the frequency and the channel duty of the PWM module assigned task.
+   *
+   * @param pwm       a PWM module.
+   * @param channel   a channel number of the PWM module.
+   * @param tolerance max deviation of the period and the pulse width in percentages of the period.
+   * @return true if the reference has been set successfully.
+   */
+  virtual bool setReference(::Pwm& pwm, int32 channel, float32 tolerance) = 0;
+
+  /**
+   * Resets the PWM module reference.
+   */
+  virtual void resetReference() = 0;
+
+  /**
+   * Returns a number of the measured periods, which mismatch the reference.
+   *
+   * @return the number of periods, or ERROR if error has been occurred.
+   */
+  virtual int32 getMismatchesNumber() const = 0;
+
+  /**
+   * Resets the number of mismatching periods.
+   */
+  virtual void resetMismatches() = 0;
+
+  /**
+   * Sets a mismatch handler.
+   *
+   * The handler is called in the interrupt context when a measured period
+   * mismatches the reference.
+   *
+   * @param handler a user handler.
+   * @return true if the handler has been set successfully.
+   */
+  virtual bool setHandler(::InterruptTask& handler) = 0;
+
+  /**
+   * Resets the mismatch handler.
+   */
+  virtual void resetHandler() = 0;
+
+  /**
+   * Returns the driver resource interface.
+   *
+   * The PWM output has to be routed to the capture pin of the module outside,
+   * which are GPIO24 to GPIO27 for the eCAP1 to eCAP4 modules, and
+   * GPIO48 and GPIO49 for the eCAP5 and eCAP6 modules.
+   *
+   * @param number   a number of an eCAP module from 1 to 6.
+   * @param capacity a number of the measured periods in the ring buffer.
+   * @return the eCAP module driver interface, or null if error has been occurred.
+   */
+  static ::Capture* create(int32 number, int32 capacity);
+
+  /**
+   * Initializes the driver.
+   *
+   * @param sourceClock the CPU oscillator source clock in Hz.
+   * @return true if no errors are occurred.
+   */
+  static bool init(int32 sourceClock);
+
+  /**
+   * Deinitializes the driver.
+   */
+  static void deinit();
+
+};
+#endif // DRIVER_CAPTURE_HPP_
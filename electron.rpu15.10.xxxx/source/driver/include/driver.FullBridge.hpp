@@ -4,26 +4,178 @@
  * @author    Sergey Baigudin, sergey@baigudin.software
  */
 #ifndef DRIVER_FULL_BRIDGE_HPP_
-#define DRIVER_PLL_HPP_
+#define DRIVER_FULL_BRIDGE_HPP_
 
 #include "driver.Types.hpp"
+#include "driver.Pwm.hpp"
 
 class FullBridge
 {
 
 public:
 
+  /**
+   * Number of the bridge legs.
+   */
+  static const int32 LEGS_NUMBER = 2;
+
+  /**
+   * The latched fault causes.
+   */
+  enum Fault
+  {
+    /**
+     * No fault has been occurred.
+     */
+    FAULT_NONE = 0x0,
+
+    /**
+     * The DRV8432 FAULT output has been active.
+     */
+    FAULT_BRIDGE = 0x1,
+
+    /**
+     * The DRV8432 OTW over-temperature warning output has been active.
+     */
+    FAULT_TEMPERATURE = 0x2,
+
+    /**
+     * The legs have been tripped, but no fault output has been active.
+     */
+    FAULT_UNKNOWN = 0x4
+
+  };
+
+  /**
+   * Destructor.
+   */
+  virtual ~FullBridge(){}
+
+  /**
+   * Starts the phase-shifted full-bridge.
+   *
+   * Each leg generates a 50 percentage duty on its channel A, and the channel B
+   * is the complementary output with the dead-band delays. The legs are started
+   * in the same period, and the second leg is synchronized by the first one
+   * on each period with the current phase shift.
+   *
+   * @param frequency a frequency integer part of the legs in Hz.
+   * @param fraction  a frequency fractional part of the legs in 1/65536 Hz.
+   * @return true if the bridge has been started successfully.
+   */
+  virtual bool start(int32 frequency, uint16 fraction=0) = 0;
+
+  /**
+   * Stops the full-bridge.
+   */
+  virtual void stop() = 0;
+
+  /**
+   * Sets the phase shift time of the legs.
+   *
+   * The second leg leads the first leg by the time, which is limited to
+   * one time-base clock less than the period.
+   * The phase registers are written by one access and loaded on next synchronization,
+   * therefore the method might be called on each period from an interrupt service routine.
+   *
+   * @param time the phase shift time in ns.
+   * @return true if the phase has been set successfully.
+   */
+  virtual bool setPhase(int32 time) = 0;
+
+  /**
+   * Sets the phase shift of the legs in steps of the phase resolution.
+   *
+   * @param steps the phase shift in steps.
+   * @return true if the phase has been set successfully.
+   */
+  virtual bool setPhaseSteps(int32 steps) = 0;
+
+  /**
+   * Returns the achieved resolution of the phase shift.
+   *
+   * @return the phase resolution in ns, or ERROR if error has been occurred.
+   */
+  virtual float32 getPhaseResolution() const = 0;
+
+  /**
+   * Returns a PWM module of a leg.
+   *
+   * @param leg a leg index from 0 to LEGS_NUMBER - 1.
+   * @return reference to the PWM module interface.
+   */
+  virtual ::Pwm& getLeg(int32 leg) = 0;
+
+  /**
+   * Sets monitoring of the DRV8432 fault outputs.
+   *
+   * The active-low FAULT and OTW outputs are connected to the trip-zone inputs,
+   * which are set as the one-shot trip sources of both legs, and the outputs
+   * of the legs are forced low by the hardware without any software latency.
+   * The trip interrupt service routine latches the fault causes by reading the pins.
+   *
+   * @param fault   a trip zone number from 1 to 6 of the FAULT output, or zero if it is not monitored.
+   * @param otw     a trip zone number from 1 to 6 of the OTW output, or zero if it is not monitored.
+   * @param holdoff min number of PWM periods between the fault outputs release and a restart.
+   * @return true if the monitoring has been set successfully.
+   */
+  virtual bool setMonitor(int32 fault, int32 otw, int32 holdoff) = 0;
+
+  /**
+   * Returns the latched fault causes.
+   *
+   * @return the fault causes mask, or ERROR if error has been occurred.
+   */
+  virtual int32 getFault() const = 0;
+
+  /**
+   * Tests if the legs are tripped by a fault.
+   *
+   * @return true if the legs are tripped.
+   */
+  virtual bool isFaulted() const = 0;
+
+  /**
+   * Restarts the legs after a fault.
+   *
+   * The method should be called periodically while it returns false.
+   * The hold-off time is started when the method is called and the fault 
+   * outputs are released, and it is restarted if an output is active again.
+   * When the hold-off time is elapsed, the one-shot trips of both legs 
+   * are cleared together, and the latched fault causes are reset. 
+   * Thus, the legs are restarted no more often than once per the hold-off time.
+   *
+   * @return true if the legs are not tripped or they have been restarted.
+   */
+  virtual bool restart() = 0;
+
+  /**
+   * Returns the phase-shifted full-bridge resource interface.
+   *
+   * The legs are the PWM modules with the passed number and the next number,
+   * which are created in the up-count mode. If the high resolution is requested,
+   * the phase of the second leg is controlled by the micro edge positioner,
+   * and the PWM clock must be equal to the CPU clock.
+   *
+   * @param clock    the PWM internal clock based on the CPU clock in Hz, or Pwm::CLOCK_AUTO.
+   * @param number   a number of the PWM module of the first leg.
+   * @param deadBand the rising and falling edges delay of the legs in ns.
+   * @param hiRes    the phase is controlled by the micro edge positioner.
+   * @return the full-bridge interface, or null if error has been occurred.
+   */
+  static ::FullBridge* create(int32 clock, int32 number, float32 deadBand, bool hiRes=false);
+
   /**
    * Initializes the driver.
    *
    * @return true if no errors are occurred.
    */
   static bool init();
-  
+
   /**
    * Deinitializes the driver.
    */
   static void deinit();
-  
+
 };
 #endif // DRIVER_FULL_BRIDGE_HPP_
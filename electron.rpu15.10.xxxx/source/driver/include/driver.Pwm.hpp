@@ -7,6 +7,7 @@
 #define DRIVER_PWM_HPP_
 
 #include "driver.Types.hpp"
+#include "driver.InterruptTask.hpp"
 
 class Pwm
 {
@@ -18,6 +19,14 @@ public:
    */
   static const int32 ERROR = -1;
 
+  /**
+   * The PWM clock, which is selected for each task frequency.
+   *
+   * The clock dividers are selected for getting the largest 
+   * time-base period count of the task frequency.
+   */
+  static const int32 CLOCK_AUTO = 0;
+
   /**
    * The PWM counting policy.
    */
@@ -67,6 +76,41 @@ public:
 
   };
   
+  /**
+   * The PWM high resolution control.
+   */  
+  enum HighResolution
+  {
+    /**
+     * The micro edge positioner controls the duty of the channel A.
+     */
+    HR_DUTY = 0,
+      
+    /**
+     * The micro edge positioner controls the phase of the channel A,
+     * which is valid only for the up counting policy.
+     */
+    HR_PHASE = 1
+
+  };
+  
+  /**
+   * The PWM retuning policy.
+   */  
+  enum Retune
+  {
+    /**
+     * The duties of the channels are kept.
+     */
+    RETUNE_DUTY = 0,
+      
+    /**
+     * The pulse widths of the channels are kept.
+     */
+    RETUNE_WIDTH = 1
+
+  };
+  
   /**
    * The PWM trigger issue.
    */  
@@ -126,6 +170,114 @@ public:
 
   };
   
+  /**
+   * The PWM trip modes.
+   */  
+  enum TripMode
+  {
+    /**
+     * The trip is released on each time-base counter equal to zero.
+     */
+    TRIP_CBC = 0,
+    
+    /**
+     * The trip is held until it is cleared by software.
+     */
+    TRIP_OSHT = 1
+
+  };
+  
+  /**
+   * The PWM output actions on a trip.
+   */  
+  enum TripAction
+  {
+    /**
+     * The output is forced to a high-impedance state.
+     */
+    TRIP_HIGH_Z = 0,
+    
+    /**
+     * The output is forced to a high state.
+     */
+    TRIP_HIGH = 1,
+    
+    /**
+     * The output is forced to a low state.
+     */
+    TRIP_LOW = 2,
+    
+    /**
+     * The output is not changed.
+     */
+    TRIP_NOTHING = 3
+
+  };
+  
+  /**
+   * The action-qualifier events.
+   */  
+  enum QualifierEvent
+  {
+    /**
+     * Time-base counter equal to zero.
+     */
+    AQ_ZERO = 0,
+    
+    /**
+     * Time-base counter equal to period.
+     */
+    AQ_PERIOD = 1,
+    
+    /**
+     * Time-base counter equal to CMPA when the timer is incrementing.
+     */
+    AQ_CMPA_UP = 2,
+    
+    /**
+     * Time-base counter equal to CMPA when the timer is decrementing.
+     */
+    AQ_CMPA_DOWN = 3,
+    
+    /**
+     * Time-base counter equal to CMPB when the timer is incrementing.
+     */
+    AQ_CMPB_UP = 4,
+    
+    /**
+     * Time-base counter equal to CMPB when the timer is decrementing.
+     */
+    AQ_CMPB_DOWN = 5
+
+  };
+  
+  /**
+   * The action-qualifier output actions.
+   */  
+  enum OutputAction
+  {
+    /**
+     * The output is not changed, or a software force is released.
+     */
+    OUTPUT_NOTHING = 0,
+    
+    /**
+     * The output is set to a low state.
+     */
+    OUTPUT_LOW = 1,
+    
+    /**
+     * The output is set to a high state.
+     */
+    OUTPUT_HIGH = 2,
+    
+    /**
+     * The output is toggled, which is not available for a software force.
+     */
+    OUTPUT_TOGGLE = 3
+
+  };
+  
   /**
    * The PWM task interface.
    */  
@@ -153,6 +305,16 @@ public:
      */
     virtual int32 getFrequency() const = 0;    
 
+    /**
+     * Returns the fractional part of the frequency of a task.
+     *
+     * @return the fractional part in 1/65536 Hz.
+     */
+    virtual uint16 getFraction() const
+    {
+      return 0;
+    }
+
     /**
      * Returns the channel duty of a task.
      *
@@ -179,7 +341,208 @@ public:
     /**
      * The next step duty in percentages.
      */    
-    float32 duty[CHANNELS]; 
+    float32 duty[CHANNELS];
+
+    /**
+     * The next step frequency fractional part in 1/65536 Hz.
+     *
+     * The member is the last one, thus it is zero if it is omitted in an initializer list.
+     */
+    uint16 fraction;
+
+  };
+
+  /**
+   * The PWM register image of a compiled task.
+   *
+   * The image is filled by the compile method of a PWM module,
+   * and must not be changed by a user. The image may be applied only to
+   * the PWM module with the same clock frequency and counting policy.
+   */
+  struct Image
+  {
+    /**
+     * Number of PWM channels of the image.
+     */
+    static const int32 CHANNELS = 2;
+
+    /**
+     * The time-base clock in Hz the image is compiled for.
+     */
+    int32 clock;
+
+    /**
+     * The time-base clock dividers in CLKDIV and HSPCLKDIV bits order of TBCTL register.
+     */
+    uint16 divider;
+
+    /**
+     * The counting policy the image is compiled for.
+     */
+    Count count;
+
+    /**
+     * Time-base period register value.
+     */
+    uint16 tbprd;
+
+    /**
+     * Counter-compare registers values.
+     */
+    uint16 cmp[CHANNELS];
+
+    /**
+     * Counter-compare A high resolution register value.
+     */
+    uint16 cmpahr;
+
+    /**
+     * Delay of the channel A high resolution edge in time-base clocks in Q16 format.
+     */
+    uint32 delay;
+
+    /**
+     * Action-qualifier control registers values.
+     */
+    uint16 aqctl[CHANNELS];
+
+    /**
+     * Compare value of zero duty for the fast duty updating.
+     */
+    int32 base;
+
+    /**
+     * Count of time-base clocks of full duty for the fast duty updating.
+     */
+    uint32 scale;
+
+    /**
+     * Inverse compare mask for the fast duty updating.
+     */
+    int32 sign;
+
+    /**
+     * The compiled task.
+     */
+    TaskData<CHANNELS> task;
+
+  };
+
+  /**
+   * The PWM module configuration profile.
+   *
+   * The profile is a snapshot of the configured registers of a PWM module, 
+   * which are the register image of the current task, the synchronization and 
+   * phase, action-qualifier software force, dead-band, chopper, SOC triggers 
+   * and trip-zone registers, and the values passed to the submodules set methods.
+   */
+  struct Profile
+  {
+    /**
+     * The register image of the current task.
+     */
+    Image image;
+
+    /**
+     * Time-base control register synchronization and phase bits.
+     */
+    uint16 tbctl;
+
+    /**
+     * Time-base phase registers values.
+     */
+    uint16 tbphs;
+    uint16 tbphshr;
+
+    /**
+     * Action-qualifier software force registers values.
+     */
+    uint16 aqsfrc;
+    uint16 aqcsfrc;
+
+    /**
+     * Dead-band registers values.
+     */
+    uint16 dbctl;
+    uint16 dbred;
+    uint16 dbfed;
+
+    /**
+     * Chopper control register value.
+     */
+    uint16 pcctl;
+
+    /**
+     * Event-trigger selection and prescale registers SOC bits.
+     */
+    uint16 etsel;
+    uint16 etps;
+
+    /**
+     * Trip-zone select and control registers values.
+     */
+    uint16 tzsel;
+    uint16 tzctl;
+
+    /**
+     * The high resolution mode, where bit 0 is the duty control, and bit 1 is the phase control.
+     */
+    uint16 hiRes;
+
+    /**
+     * The dead-band delays in ns passed to the set methods.
+     */
+    float32 rising;
+    float32 falling;
+
+    /**
+     * The chopper values passed to the set methods.
+     */
+    int32 chopperFrequency;
+    float32 chopperDuty;
+    int32 chopperPulse;
+
+  };
+
+  /**
+   * The PWM high resolution calibration report.
+   */
+  struct Calibration
+  {
+    /**
+     * Number of PWM modules.
+     */
+    static const int32 MODULES = 6;
+
+    /**
+     * Number of completed passes, which calibrate all modules in high resolution mode.
+     */
+    int32 passes;
+
+    /**
+     * Calibration time of the last pass in steps of the calibrate method.
+     */
+    int32 steps;
+
+    /**
+     * Max change of MEP scale factors in the last pass.
+     */
+    int32 drift;
+
+    /**
+     * Max change of MEP scale factors since the driver initialization.
+     */
+    int32 maxDrift;
+
+    /**
+     * Number of failed module calibrations.
+     */
+    int32 errors;
+
+    /**
+     * Last calibrated MEP scale factors of the modules, or zero if a module is not calibrated.
+     */
+    int32 mep[MODULES];
 
   };
 
@@ -200,6 +563,7 @@ public:
     Task()
     {
       task_.frequency = ERROR;
+      task_.fraction = 0;
       for(int32 i=0; i<CHANNELS; i++) task_.duty[i] = ERROR;
     }    
 
@@ -209,6 +573,7 @@ public:
     Task(const TaskData<CHANNELS>& obj)
     {
       task_.frequency = obj.frequency;
+      task_.fraction = obj.fraction;
       for(int32 i=0; i<CHANNELS; i++) task_.duty[i] = obj.duty[i];
     }      
   
@@ -218,6 +583,7 @@ public:
     Task(const Task<CHANNELS>& obj)
     {
       task_.frequency = obj.task_.frequency;
+      task_.fraction = obj.task_.fraction;
       for(int32 i=0; i<CHANNELS; i++) task_.duty[i] = obj.task_.duty[i];
     }  
     
@@ -227,6 +593,7 @@ public:
     Task(const TaskInterface& obj)
     {
       task_.frequency = obj.getFrequency();
+      task_.fraction = obj.getFraction();
       for(int32 i=0; i<CHANNELS; i++) task_.duty[i] = obj.getDuty(i);
     }    
 
@@ -255,6 +622,16 @@ public:
       return task_.frequency;
     }
 
+    /**
+     * Returns the fractional part of the frequency of a task.
+     *
+     * @return the fractional part in 1/65536 Hz.
+     */
+    virtual uint16 getFraction() const
+    {
+      return task_.fraction;
+    }
+
     /**
      * Returns the channel duty of a task.
      *
@@ -275,6 +652,7 @@ public:
     Task& operator =(const TaskData<CHANNELS>& obj)
     {
       task_.frequency = obj.frequency;
+      task_.fraction = obj.fraction;
       for(int32 i=0; i<CHANNELS; i++) task_.duty[i] = obj.duty[i];
       return *this;
     }    
@@ -288,6 +666,7 @@ public:
     Task& operator =(const TaskInterface& obj)
     {
       task_.frequency = obj.getFrequency();
+      task_.fraction = obj.getFraction();
       for(int32 i=0; i<CHANNELS; i++) task_.duty[i] = obj.getDuty(i);
       return *this;
     }      
@@ -532,11 +911,17 @@ public:
     /**
      * Sets triggering event.
      *
-     * @param issue an trigger issuing source.
-     * @param event an trigger received event.
+     * A SOC trigger is generated on each period number of received events.
+     * The period up to 3 is counted by the hardware. The greater period is counted 
+     * by the PWM interrupt service routine, which gates the SOC trigger, therefore 
+     * the PWM interrupt must be free or be generated on each the same event.
+     *
+     * @param issue  an trigger issuing source.
+     * @param event  an trigger received event.
+     * @param period a number of events for generating a SOC trigger.
      * @return true if the event has been set successfully.
      */  
-    virtual bool setEvent(int32 issue, int32 event) = 0;
+    virtual bool setEvent(int32 issue, int32 event, int32 period=1) = 0;
     
     /**
      * Resets triggering event.
@@ -544,34 +929,808 @@ public:
      * @param issue an trigger issuing source.
      */  
     virtual void resetEvent(int32 issue) = 0;
+    
+    /**
+     * Sets a handler of the PWM interrupt.
+     *
+     * The handler is called in the interrupt context on each period number
+     * of received events. After the handler has been set, the event might be
+     * changed by setting an event of the CPU_INT issue.
+     *
+     * @param handler a user handler.
+     * @param event   an trigger received event.
+     * @param period  a number of events from 1 to 3 for generating an interrupt.
+     * @return true if the handler has been set successfully.
+     */  
+    virtual bool setInterrupt(::InterruptTask& handler, int32 event, int32 period=1) = 0;
+    
+    /**
+     * Resets the handler of the PWM interrupt.
+     */  
+    virtual void resetInterrupt() = 0;
 
   };
-
-  /** 
-   * Destructor.
-   */                               
-  virtual ~Pwm(){}
   
   /**
-   * Sets a task for generating wave of the PWM module.
-   *
-   * Note: The method has to copy the passed task into internal structure data.
-   * Thus, when the method has been called, the passing task object might be deleted.
+   * The PWM Trip-Zone Submodule.
    *
-   * @param task a new task for generating.
-   * @return true if the task has been set successfully.
-   */
-  virtual bool setTask(const TaskInterface& task) = 0;
+   * The TZ1 to TZ6 zones are the GPIO12 to GPIO17 pins, which are configured 
+   * as the asynchronous trip inputs when a zone is set.
+   */  
+  class TripZone
+  {
   
-  /**
-   * Starts generating the tasked wave of the PWM module.
-   *
-   * @return true if the task has been started successfully.
-   */
-  virtual bool start() = 0;  
+  public:
+  
+    /**
+     * Destructor.
+     */  
+    virtual ~TripZone(){}
+    
+    /**
+     * Sets a trip zone as a source of the module trip.
+     *
+     * @param zone a trip zone number from 1 to 6.
+     * @param mode a trip mode.
+     * @return true if the zone has been set successfully.
+     */  
+    virtual bool setZone(int32 zone, TripMode mode) = 0;
+    
+    /**
+     * Resets a trip zone.
+     *
+     * @param zone a trip zone number from 1 to 6.
+     */  
+    virtual void resetZone(int32 zone) = 0;
+    
+    /**
+     * Sets an output action on a trip.
+     *
+     * @param channel a channel number.
+     * @param action  an output action.
+     * @return true if the action has been set successfully.
+     */  
+    virtual bool setAction(int32 channel, TripAction action) = 0;
+    
+    /**
+     * Sets a trip interrupt handler.
+     *
+     * The handler is called in the interrupt context when a trip is occurred,
+     * after that the driver clears the trip interrupt flag, 
+     * but it does not clear the trip flags.
+     *
+     * @param handler a user handler.
+     * @return true if the handler has been set successfully.
+     */  
+    virtual bool setHandler(::InterruptTask& handler) = 0;
+    
+    /**
+     * Resets the trip interrupt handler.
+     */  
+    virtual void resetHandler() = 0;
+    
+    /**
+     * Forces a trip by software.
+     *
+     * @param mode a trip mode.
+     */  
+    virtual void force(TripMode mode=TRIP_OSHT) = 0;
+    
+    /**
+     * Tests if a trip has been occurred.
+     *
+     * @param mode a trip mode.
+     * @return true if the trip flag is set.
+     */  
+    virtual bool isTripped(TripMode mode) const = 0;
+    
+    /**
+     * Clears a trip.
+     *
+     * The one-shot trip outputs are released after the trip flag is cleared.
+     *
+     * @param mode a trip mode.
+     */  
+    virtual void clear(TripMode mode) = 0;
+
+  };
+
+  /**
+   * The PWM Action-Qualifier Submodule.
+   *
+   * Each counting policy sets the default actions of its channels when a module 
+   * is created, and the actions are kept in the register image of the module.
+   * The actions might be changed for generating asymmetric waveforms, for instance, 
+   * a channel might be set by CMPA and cleared by CMPB for independent edges.
+   */  
+  class ActionQualifier
+  {
+  
+  public:
+  
+    /**
+     * Destructor.
+     */  
+    virtual ~ActionQualifier(){}
+    
+    /**
+     * Sets an output action on an event.
+     *
+     * @param channel a channel number.
+     * @param event   an action-qualifier event.
+     * @param action  an output action.
+     * @return true if the action has been set successfully.
+     */  
+    virtual bool setQualifier(int32 channel, QualifierEvent event, OutputAction action) = 0;
+    
+    /**
+     * Returns an output action on an event.
+     *
+     * @param channel a channel number.
+     * @param event   an action-qualifier event.
+     * @return the output action, or ERROR if error has been occurred.
+     */  
+    virtual int32 getQualifier(int32 channel, QualifierEvent event) const = 0;
+    
+    /**
+     * Resets the output actions of a channel to the counting policy default.
+     *
+     * @param channel a channel number.
+     */  
+    virtual void resetQualifiers(int32 channel) = 0;
+    
+    /**
+     * Forces an output continuously by software.
+     *
+     * The force is loaded immediately and it overrides the output
+     * until the method is called with OUTPUT_NOTHING. The method does not
+     * lock the module, therefore it might be called from an interrupt service routine.
+     *
+     * @param channel a channel number.
+     * @param action  OUTPUT_LOW, OUTPUT_HIGH, or OUTPUT_NOTHING for releasing the output.
+     * @return true if the output has been forced successfully.
+     */  
+    virtual bool setForce(int32 channel, OutputAction action) = 0;
+
+  };
+
+  /**
+   * The group of PWM modules which are updated in the same period.
+   *
+   * New tasks and phases are staged in the group by the set methods,
+   * and nothing is written to the PWM modules until the commit method is called.
+   * The commit method writes all staged values to the shadow registers of
+   * all members in one window, where no member time-base counter is close to zero.
+   * Thus, the hardware loads the new values of all members on the same
+   * counter-equal-zero event of synchronized modules.
+   */
+  class Group
+  {
+
+  public:
+
+    /**
+     * Max number of the group members.
+     */
+    static const int32 MAX_MEMBERS = 6;
+
+    /**
+     * Destructor.
+     */
+    virtual ~Group(){}
+
+    /**
+     * Returns a number of the group members.
+     *
+     * @return the members number, or ERROR if error has been occurred.
+     */
+    virtual int32 getMembersNumber() const = 0;
+
+    /**
+     * Stages a task for a member.
+     *
+     * The method compiles the task by the member PWM module.
+     *
+     * @param member an index of a member in the array passed to the create method.
+     * @param task   a new task of the member.
+     * @return true if the task has been staged successfully.
+     */
+    virtual bool setTask(int32 member, const TaskInterface& task) = 0;
+
+    /**
+     * Stages a register image for a member.
+     *
+     * @param member an index of a member in the array passed to the create method.
+     * @param image  a register image compiled by the member PWM module.
+     * @return true if the image has been staged successfully.
+     */
+    virtual bool setImage(int32 member, const Image& image) = 0;
+
+    /**
+     * Stages a phase shift time for a member.
+     *
+     * @param member an index of a member in the array passed to the create method.
+     * @param time   the PWN signals shift time during synchronization in ns.
+     * @return true if the phase has been staged successfully.
+     */
+    virtual bool setPhase(int32 member, int32 time) = 0;
+
+    /**
+     * Writes all staged values to the members.
+     *
+     * The method disables global interrupts for the time of waiting a load window
+     * and writing the registers, which is no more than one period of the slowest member.
+     * If the synchronize argument is true, a software synchronization pulse is forced
+     * by the member with the smallest module number, and the other members must pass
+     * the pulse through the synchronization chain to load their staged phases.
+     *
+     * The window exists if the time between two counter-equal-zero events of each member
+     * is longer than 96 SYSCLKOUT cycles of writing one member multiplied by the members number,
+     * that is the frequency must be less than about 260 kHz for six members in the up-count mode 
+     * with the 150 MHz time-base clock, or about 1.5 MHz for one member. The method returns
+     * false if no window has been found.
+     *
+     * @param synchronize force a software synchronization pulse after writing.
+     * @return true if the staged values have been written successfully.
+     */
+    virtual bool commit(bool synchronize=false) = 0;
+
+    /**
+     * Starts the members as an interleaved converter.
+     *
+     * The method sets the same frequency to all members keeping their duties,
+     * chains the synchronization signals from the member with the smallest
+     * module number, which synchronizes the others when its counter is equal to zero,
+     * and spreads the phases of the members by 360/N degrees in order of
+     * the module numbers. If the phase of a member is in high resolution, the fractional
+     * part of its phase is loaded to the high resolution phase register.
+     * The method might be called again with new frequency for re-balancing the phases.
+     *
+     * All members must have the same counting policy and clock frequency,
+     * and the PWM modules between the members, which are not in the group,
+     * must pass the synchronization through.
+     * The frequency is limited by the load window as the commit method describes.
+     *
+     * @param frequency a frequency of the members in Hz.
+     * @return true if the members have been started successfully.
+     */
+    virtual bool interleave(int32 frequency) = 0;
+
+    /**
+     * Forces a trip of all members by software.
+     *
+     * The method does not lock the members, and writes 
+     * the trip force register of each member once, therefore
+     * it might be called from an interrupt service routine.
+     *
+     * @param mode a trip mode.
+     */
+    virtual void trip(TripMode mode=TRIP_OSHT) = 0;
+
+    /**
+     * Returns a group of PWM modules.
+     *
+     * @param members an array of PWM modules created by the driver.
+     * @param number  a number of the PWM modules in the array.
+     * @return the group interface, or null if error has been occurred.
+     */
+    static ::Pwm::Group* create(::Pwm** members, int32 number);
+
+  };
+
+  /**
+   * The sinusoidal PWM generator.
+   *
+   * The generator samples a sine table to a buffer of the compare values of one output
+   * wave period, and a DMA channel with the number of the PWM module writes the values 
+   * to the counter-compare registers on each SOC event of the module. Thus, the CPU 
+   * is not used for generating the wave. The channel A duty is modulated by the sine, 
+   * and the channel B duty is modulated by the inverted sine for the unipolar 
+   * modulation of a full bridge.
+   *
+   * A new modulation index or output frequency is sampled to the free buffer,
+   * which is switched by the DMA at the end of the current output wave period.
+   * The PWM module task has to be set before the generator is started, and 
+   * the driver has to be built with the DRIVER_PWM_DMA definition, which is not
+   * set by default. Otherwise, the create method returns null.
+   */
+  class Sine
+  {
+
+  public:
+
+    /**
+     * Destructor.
+     */
+    virtual ~Sine(){}
+
+    /**
+     * Sets a wave and starts the generator if it is not started.
+     *
+     * If the generator is started, the method returns false while 
+     * the DMA has not switched the buffer of a previous wave, or if no load window 
+     * has been found, which is limited by the module frequency as the retune method describes.
+     *
+     * @param index     a modulation index from 0.0 to 1.0.
+     * @param frequency a frequency of the output wave in Hz.
+     * @return true if the wave has been set successfully.
+     */
+    virtual bool setWave(float32 index, int32 frequency) = 0;
+
+    /**
+     * Stops the generator.
+     *
+     * The counter-compare registers keep the last written values.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * Returns the output wave frequency.
+     *
+     * @return the real frequency in Hz, or ERROR if the generator is not started.
+     */
+    virtual float32 getFrequency() const = 0;
+
+    /**
+     * Returns a sinusoidal PWM generator.
+     *
+     * @param pwm      a PWM module created by the driver.
+     * @param table    a sine table of one period in Q15 format.
+     * @param length   a number of the table elements.
+     * @param capacity max number of PWM periods in one output wave period.
+     * @param issue    the SOC signal which triggers the DMA channel.
+     * @return the generator interface, or null if error has been occurred.
+     */
+    static ::Pwm::Sine* create(::Pwm& pwm, const int16* table, int32 length, int32 capacity, TriggerIssue issue=ADC_SOCA);
+
+  };
+
+  /**
+   * The three-phase space vector modulator.
+   *
+   * The modulator drives a three-phase bridge by three PWM modules in the up-down-count 
+   * mode, which have the same frequency and synchronized time-base counters. A voltage 
+   * reference is normalized to the DC link voltage, and it is in the linear range 
+   * if its magnitude is no more than 1/sqrt(3). The modulator selects the sector 
+   * of the reference by the order of its phase voltages, calculates the dwell times
+   * of two active vectors and centers them by splitting the zero vector time equally. 
+   * A reference out of the linear range is limited to the hexagon boundary keeping its angle.
+   *
+   * The counter-compare A registers of three modules are written in one window before 
+   * next counter-equal-zero event, where no other writing is possible, and the method 
+   * does not use any mutex, therefore it might be called from an interrupt service routine 
+   * of the first module. The channels B of the modules might be used as the complementary 
+   * outputs by the dead-band submodules.
+   */
+  class SpaceVector
+  {
+
+  public:
+
+    /**
+     * Number of the modulator phases.
+     */
+    static const int32 PHASES_NUMBER = 3;
+
+    /**
+     * Destructor.
+     */
+    virtual ~SpaceVector(){}
+
+    /**
+     * Sets a voltage reference in the stationary frame.
+     *
+     * @param alpha an alpha component normalized to the DC link voltage.
+     * @param beta  a beta component normalized to the DC link voltage.
+     * @return true if the compare values have been written successfully, or false if 
+     *         no load window has been found, which is limited by the module frequency
+     *         as the retune method of the PWM module describes.
+     */
+    virtual bool setVoltage(float32 alpha, float32 beta) = 0;
+
+    /**
+     * Sets a voltage reference by its magnitude and angle.
+     *
+     * @param magnitude a magnitude normalized to the DC link voltage.
+     * @param angle     an angle from the phase A axis in radians.
+     * @return true if the compare values have been written successfully.
+     */
+    virtual bool setPolar(float32 magnitude, float32 angle) = 0;
+
+    /**
+     * Returns the sector of the last voltage reference.
+     *
+     * @return the sector from 1 to 6, or ERROR if no reference has been set.
+     */
+    virtual int32 getSector() const = 0;
+
+    /**
+     * Returns a space vector modulator.
+     *
+     * The tasks of the modules have to be started before the modulator is created.
+     * The modulator is not created if the module periods are not the same, or the time-base 
+     * counters are not synchronized without a phase shift, and a voltage reference is
+     * not written if the periods become different.
+     *
+     * @param phases an array of PHASES_NUMBER PWM modules for the phases A, B and C.
+     * @return the modulator interface, or null if error has been occurred.
+     */
+    static ::Pwm::SpaceVector* create(::Pwm** phases);
+
+  };
+
+  /**
+   * The ramp generator.
+   *
+   * The generator moves a duty, frequency or phase shift of its members from the current 
+   * values to the staged targets over a number of PWM periods by a linear or S-curve profile.
+   * The values are written on each counter-equal-zero event in the interrupt service routine 
+   * of the first member, which handler is used by the generator while a ramp is going, 
+   * thus no thread is needed and the ramp time is defined by the PWM period only.
+   *
+   * A duty is written by the fast compare path, and the target tasks of the members are 
+   * compiled and written with the high resolution part when the ramp is completed. A frequency is compiled on each step keeping the duties, 
+   * thus its period must be longer than the compiling time of the members, and 
+   * the time-base clock dividers must not be changed by the target frequencies.
+   */
+  class Ramp
+  {
+
+  public:
+
+    /**
+     * Max number of the generator members.
+     */
+    static const int32 MAX_MEMBERS = 6;
+
+    /**
+     * The ramped values.
+     */
+    enum Quantity
+    {
+      /**
+       * The channel duty in percentages.
+       */
+      DUTY = 0,
+
+      /**
+       * The frequency in Hz.
+       */
+      FREQUENCY = 1,
+
+      /**
+       * The phase shift time in ns.
+       */
+      PHASE = 2
+
+    };
+
+    /**
+     * The ramp profiles.
+     */
+    enum Shape
+    {
+      /**
+       * The value is changed with a constant speed.
+       */
+      LINEAR = 0,
+
+      /**
+       * The value speed is raised and lowered smoothly by the cubic polynomial 3x^2 - 2x^3.
+       */
+      S_CURVE = 1
+
+    };
+
+    /**
+     * Destructor.
+     */
+    virtual ~Ramp(){}
+
+    /**
+     * Returns a number of the generator members.
+     *
+     * @return the members number, or ERROR if error has been occurred.
+     */
+    virtual int32 getMembersNumber() const = 0;
+
+    /**
+     * Stages a target value for a member.
+     *
+     * The value of a member without a staged target is not changed by a ramp.
+     * The staged targets are reset when a ramp is completed or stopped.
+     *
+     * @param member an index of a member in the array passed to the create method.
+     * @param target a target value in units of the quantity of the ramp.
+     * @return true if the target has been staged successfully.
+     */
+    virtual bool setTarget(int32 member, float32 target) = 0;
+
+    /**
+     * Starts a ramp of the staged targets.
+     *
+     * The frequency is ramped only if the current and the target periods of each member 
+     * have a load window, which is limited by the module frequency as the retune method
+     * of the PWM module describes. A step without the window is skipped.
+     *
+     * @param quantity a ramped value.
+     * @param channel  a channel number of the duty, which is ignored for other values.
+     * @param periods  a number of PWM periods of the first member of the ramp.
+     * @param shape    a profile of the ramp.
+     * @return true if the ramp has been started successfully.
+     */
+    virtual bool start(Quantity quantity, int32 channel, int32 periods, Shape shape=LINEAR) = 0;
+
+    /**
+     * Stops a ramp.
+     *
+     * The members keep the last written values, and the handler is not called.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * Tests if a ramp is going.
+     *
+     * @return true if the ramp has not been completed.
+     */
+    virtual bool isRamping() const = 0;
+
+    /**
+     * Sets a ramp completion handler.
+     *
+     * The handler is called in the interrupt context after the last values 
+     * have been written, and a new ramp might be started from it.
+     *
+     * @param handler a user handler.
+     * @return true if the handler has been set successfully.
+     */
+    virtual bool setHandler(::InterruptTask& handler) = 0;
+
+    /**
+     * Resets the ramp completion handler.
+     */
+    virtual void resetHandler() = 0;
+
+    /**
+     * Returns a ramp generator.
+     *
+     * @param members an array of PWM modules created by the driver.
+     * @param number  a number of the PWM modules in the array.
+     * @return the generator interface, or null if error has been occurred.
+     */
+    static ::Pwm::Ramp* create(::Pwm** members, int32 number);
+
+  };
+
+  /**
+   * The spread-spectrum frequency dither.
+   *
+   * The dither spreads the spectrum of the PWM signal by changing its period 
+   * on each period within a band around the period of the assigned task.
+   * The period and compare values of all periods of a sequence are precomputed 
+   * to a table when the dither is started, and the interrupt service routine 
+   * of the counter-equal-zero event of the PWM module only copies next table 
+   * entry to the shadow registers. Thus, the duties of the assigned task are kept 
+   * in each period, and the mean period is kept for the triangular sequence.
+   *
+   * The PWM module interrupt handler is used by the dither while it is started,
+   * and the module task must not be changed until the dither is stopped.
+   */
+  class Dither
+  {
+
+  public:
+
+    /**
+     * The period sequences.
+     */
+    enum Sequence
+    {
+      /**
+       * The period is changed linearly from min to max and back.
+       */
+      TRIANGLE = 0,
+
+      /**
+       * The period is changed by a pseudo-random sequence of a linear feedback shift register.
+       */
+      RANDOM = 1
+
+    };
+
+    /**
+     * Destructor.
+     */
+    virtual ~Dither(){}
+
+    /**
+     * Starts the dither.
+     *
+     * The nominal values are restored in a load window when the dither is stopped, 
+     * thus the method returns false if the task period has no window, which is limited 
+     * by the module frequency as the retune method of the PWM module describes.
+     *
+     * @param band     max deviation of the period in percentages of the task period.
+     * @param length   a number of PWM periods in the sequence from 2 to the capacity.
+     * @param sequence a sequence of the periods.
+     * @return true if the dither has been started successfully.
+     */
+    virtual bool start(float32 band, int32 length, Sequence sequence=TRIANGLE) = 0;
+
+    /**
+     * Stops the dither.
+     *
+     * The period and compare values of the assigned task are restored.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * Tests if the dither is started.
+     *
+     * @return true if the dither is started.
+     */
+    virtual bool isDithering() const = 0;
+
+    /**
+     * Returns a spread-spectrum frequency dither.
+     *
+     * @param pwm      a PWM module created by the driver.
+     * @param capacity max number of PWM periods in the sequence.
+     * @return the dither interface, or null if error has been occurred.
+     */
+    static ::Pwm::Dither* create(::Pwm& pwm, int32 capacity);
+
+  };
+
+  /** 
+   * Destructor.
+   */                               
+  virtual ~Pwm(){}
+  
+  /**
+   * Sets a task for generating wave of the PWM module.
+   *
+   * Note: The method has to copy the passed task into internal structure data.
+   * Thus, when the method has been called, the passing task object might be deleted.
+   *
+   * @param task a new task for generating.
+   * @return true if the task has been set successfully.
+   */
+  virtual bool setTask(const TaskInterface& task) = 0;
+  
+  /**
+   * Starts generating the tasked wave of the PWM module.
+   *
+   * The compiled task is written as the apply method writes an image.
+   *
+   * @return true if the task has been started successfully.
+   */
+  virtual bool start() = 0;
+
+  /**
+   * Compiles a task into a register image.
+   *
+   * The method converts the passed task into the register values once,
+   * thus switching between compiled operating points by the apply method
+   * does not need any calculation. The method does not change assigned task.
+   *
+   * @param task  a task for compiling.
+   * @param image a register image to be filled.
+   * @return true if the task has been compiled successfully.
+   */
+  virtual bool compile(const TaskInterface& task, Image& image) const = 0;
+
+  /**
+   * Starts generating a wave of compiled register image.
+   *
+   * The method writes the period, compare and action-qualifier registers,
+   * and assigns the compiled task as current task of the PWM module.
+   * The period and compare values are loaded by hardware from the shadow registers
+   * when the time-base counter is equal to zero. The registers are written in one 
+   * window before the event with disabled global interrupts, and the method returns
+   * false if no window has been found, which is limited by the module frequency 
+   * as the retune method describes.
+   *
+   * @param image a register image compiled by the PWM module.
+   * @return true if the image has been applied successfully.
+   */
+  virtual bool apply(const Image& image) = 0;
+
+  /**
+   * Takes a snapshot of the module configuration.
+   *
+   * The software prescaled SOC triggers and bursts are not kept by profiles,
+   * thus the method returns false if they are used.
+   *
+   * @param profile a profile to be filled.
+   * @return true if the snapshot has been taken successfully.
+   */
+  virtual bool snapshot(Profile& profile) const = 0;
+
+  /**
+   * Restores the module configuration from a profile.
+   *
+   * The method writes all registers of the profile in one window before 
+   * next counter-equal-zero event with disabled global interrupts, which 
+   * are disabled for no more than one period of the module. The profile 
+   * must be taken by this module in the same high resolution mode.
+   * The window is limited by the module frequency as the retune method describes.
+   *
+   * @param profile a profile taken by the snapshot method.
+   * @return true if the profile has been restored successfully.
+   */
+  virtual bool restore(const Profile& profile) = 0;
+
+  /**
+   * Changes the frequency of the generating wave.
+   *
+   * The period and compare values are written to the shadow registers
+   * in a window before next counter-equal-zero event, thus the hardware loads 
+   * them together at the event and no period is truncated or doubled.
+   * The method returns after the new period has been loaded.
+   * The time-base clock dividers must not be changed by the new frequency, 
+   * as they have no shadow registers.
+   *
+   * The window exists if the time between two counter-equal-zero events is longer than
+   * 96 SYSCLKOUT cycles of writing the registers, that is the module frequency must be 
+   * less than about 1.5 MHz for the up-count mode with the 150 MHz time-base clock.
+   * The method returns false if the current or the new period has no window, 
+   * or the window has not been found for two periods.
+   *
+   * @param frequency a new frequency in Hz.
+   * @param policy    a value which is kept for the new frequency.
+   * @return true if the new frequency has been loaded successfully.
+   */
+  virtual bool retune(int32 frequency, Retune policy=RETUNE_DUTY) = 0;
+
+  /**
+   * Changes the frequency of the generating wave with a sub-hertz resolution.
+   *
+   * The method is the same as the above one, but the frequency has 
+   * the fractional part. The period is counted in the time-base clocks, 
+   * as the module has no high resolution period register, thus 
+   * the fraction takes effect when the period has enough clocks.
+   *
+   * @param frequency a new frequency integer part in Hz.
+   * @param fraction  a new frequency fractional part in 1/65536 Hz.
+   * @param policy    a value which is kept for the new frequency.
+   * @return true if the new frequency has been loaded successfully.
+   */
+  virtual bool retune(int32 frequency, uint16 fraction, Retune policy=RETUNE_DUTY) = 0;
+  
+  /**
+   * Generates an exact number of pulses, after that the outputs are forced low.
+   *
+   * The outputs are forced low by the action-qualifier continuous software force,
+   * and the force is released on the period boundary event where the outputs
+   * are low, that is the counter-equal-period event for the up and down counting 
+   * policies, and the counter-equal-zero event for the up-down counting policy. 
+   * The PWM interrupt service routine counts the events, and it writes the force 
+   * during the last pulse, so that the hardware loads it on the next boundary event.
+   * A burst is re-armed by calling the method again when the previous one is completed,
+   * and the outputs might be released by the action-qualifier submodule after a burst.
+   *
+   * The PWM interrupt must not be used with other event or period while a burst is generated.
+   * The force is written in a load window, which is limited by the module frequency 
+   * as the retune method describes.
+   *
+   * @param pulses a number of pulses from 1 to 65535.
+   * @return true if the burst has been started successfully.
+   */
+  virtual bool burst(int32 pulses) = 0;
   
+  /**
+   * Tests if a burst is being generated.
+   *
+   * @return true if the last pulse has not been completed.
+   */
+  virtual bool isBursting() const = 0;
+
   /**
    * Stops generating the wave of the PWM module.
+   *
+   * A burst being generated is cancelled, and the outputs are forced low
+   * as they are forced after a completed burst.
    */      
   virtual void stop() = 0;   
   
@@ -602,10 +1761,15 @@ public:
    *
    * The method only enables high resolution mode and does not restart stared task.
    * Thus, only the next started task will be executed in high resolution.
+   * The micro edge positioner of the module controls either the duty or the phase,
+   * and the other value is set with the time-base clock resolution.
+   * The phase control is rejected for the down and up-down counting policies,
+   * as the hardware supports the high resolution phase only in the up-count mode.
    *
+   * @param control a value controlled by the micro edge positioner.
    * @return true if high resolution mode is set successfully.
    */        
-  virtual bool enableHighResolution() = 0;
+  virtual bool enableHighResolution(HighResolution control=HR_DUTY) = 0;
   
   /**
    * Disables the PWM channels in high resolution mode.
@@ -631,6 +1795,26 @@ public:
    * @return the signal frequency in Hz, or ERROR if error has been occurred.
    */        
   virtual int32 getSignalFrequency(bool set=false) const = 0;  
+
+  /**
+   * Returns the fractional part of the PWM signal frequency of currently assigned task.
+   *
+   * The calculated value is the fractional part of the time-base clock divided 
+   * by the signal period, which is rounded down.
+   *
+   * @param set flag allows getting the set or calculated value.
+   * @return the fractional part in 1/65536 Hz, or ERROR if error has been occurred.
+   */        
+  virtual int32 getSignalFraction(bool set=false) const = 0;
+
+  /**
+   * Returns the PWM signal period.
+   *
+   * The signal frequency is exactly the clock frequency divided by the period.
+   *
+   * @return the period in the time-base clocks, or ERROR if error has been occurred.
+   */        
+  virtual int32 getSignalPeriod() const = 0;
   
   /**
    * Returns the PWM clock frequency.
@@ -652,7 +1836,40 @@ public:
    * @return the channel duty in percentages, or ERROR if error has been occurred.
    */        
   virtual float32 getDuty(int32 channel, bool set=false) const = 0;
-  
+
+  /**
+   * Sets a compare value of the PWM module channel.
+   *
+   * The method is a fast path for closed-loop control and might be called
+   * in an interrupt handler. It does not lock the resource, does not change
+   * the assigned task, and writes only the shadowed compare register of
+   * the channel, which will be loaded by hardware when the time-base counter
+   * is equal to zero. Thus, the wave is never corrupted inside a period.
+   * The method takes about 15 CPU cycles including the virtual call, which is
+   * an estimate from the generated code and has not been measured on hardware.
+   *
+   * @param channel available number of channel.
+   * @param value   a raw compare value in time-base clocks.
+   */
+  virtual void setCompare(int32 channel, uint16 value) = 0;
+
+  /**
+   * Sets a duty of the PWM module channel.
+   *
+   * The method is a fast path for closed-loop control and might be called
+   * in an interrupt handler. It scales the passed duty to the period of
+   * the started task with one multiplication, does not lock the resource,
+   * does not change the assigned task, and writes only the shadowed compare
+   * register of the channel. The high resolution part is not updated.
+   * A duty greater than 0x8000 is saturated to 100%.
+   * The method takes about 30 CPU cycles including the virtual call, which is
+   * an estimate from the generated code and has not been measured on hardware.
+   *
+   * @param channel available number of channel.
+   * @param duty    a duty in Q15 format, where 0x8000 is 100%.
+   */
+  virtual void setDuty(int32 channel, uint16 duty) = 0;
+
   /**
    * Synchronizes the PWM module with a PWM module later in a synchronization chain.
    *
@@ -684,16 +1901,39 @@ public:
   /**
    * Sets the PWM module phase shift time.
    *
+   * If the phase is controlled by the micro edge positioner, 
+   * the time is rounded to the micro edge positioner steps.
+   *
    * @param time the PWN signals shift time during synchronization in ns.
    */      
   virtual void setPhase(int32 time) = 0;
 
+  /**
+   * Sets the PWM module phase shift in steps of the phase resolution.
+   *
+   * If the phase is controlled by the micro edge positioner, a step is
+   * the micro edge positioner step, otherwise it is one time-base clock.
+   *
+   * @param steps the PWN signals shift during synchronization in steps.
+   */      
+  virtual void setPhaseSteps(int32 steps) = 0;
+
   /**
    * Returns the PWM module phase shift time.
    *
    * @return the PWN signals shift time during synchronization in ns.
    */      
   virtual int32 getPhase() const = 0;
+
+  /**
+   * Returns the achieved resolution of the PWM module phase shift.
+   *
+   * The value is one step of the setPhaseSteps method, which is either
+   * the calibrated micro edge positioner step or one time-base clock period.
+   *
+   * @return the phase resolution in ns, or ERROR if error has been occurred.
+   */      
+  virtual float32 getPhaseResolution() const = 0;
   
   /**
    * Returns the PWM module phase enabling key.
@@ -761,15 +2001,57 @@ public:
    */      
   virtual ::Pwm::EventTrigger& getTrigger() = 0;
   
+  /**
+   * Tests if the PWM module has trip-zone submodule.
+   *
+   * @return true if the module has trip-zone submodule.
+   */      
+  virtual bool isTripZoned() const = 0;
+  
+  /**
+   * Returns a trip-zone submodule interface.
+   *
+   * @return reference to the trip-zone submodule interface.
+   */      
+  virtual ::Pwm::TripZone& getTripZone() = 0;
+  
+  /**
+   * Returns an action-qualifier submodule interface.
+   *
+   * @return reference to the action-qualifier submodule interface.
+   */      
+  virtual ::Pwm::ActionQualifier& getActionQualifier() = 0;
+  
   /**
    * Returns the driver resource interface.
    *
-   * @param clock the desiring PWM clock frequency in Hz.      
+   * @param clock the desiring PWM clock frequency in Hz, or CLOCK_AUTO.
    * @param number a number of a PWM module.
    * @param count a counting policy of the PWM module behavior.   
    * @return the PWM module driver interface, or null if error has been occurred.
    */
   static ::Pwm* create(int32 clock, int32 number, Count count);
+
+  /**
+   * Executes one step of the high resolution calibration.
+   *
+   * The method is a cooperative background service, which should be called 
+   * periodically in an idle loop or a low priority thread. Each call executes
+   * one short step of TI SFO library for a module in high resolution mode.
+   * When the calibration of a module is completed, new MEP scale factor is set 
+   * to the module and its CMPAHR register is updated by one register write.
+   *
+   * @return true if a calibration step has been executed.
+   */
+  static bool calibrate();
+
+  /**
+   * Returns the high resolution calibration report.
+   *
+   * @param report a report to be filled.
+   * @return true if the report has been filled successfully.
+   */
+  static bool getCalibration(Calibration& report);
    
   /**
    * Initializes the driver.
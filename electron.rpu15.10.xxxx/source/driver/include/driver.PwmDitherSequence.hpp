@@ -0,0 +1,127 @@
+/**
+ * Spread-spectrum dither sequence of a PWM period.
+ *
+ * The sequence generates the offsets of consecutive PWM periods from the period 
+ * of a task, and calculates the compare values of the dithered periods. It uses 
+ * target types only, thus it is shared by the dither of the PWM driver and 
+ * the host simulation of the dithered wave spectrum.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_PWM_DITHER_SEQUENCE_HPP_
+#define DRIVER_PWM_DITHER_SEQUENCE_HPP_
+
+#include "driver.Types.hpp"
+
+class PwmDitherSequence
+{
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param deviation max offset of a period in time-base clocks.
+   * @param length    a number of periods in the sequence.
+   * @param random    the offsets are pseudo-random, otherwise they are triangular.
+   */
+  PwmDitherSequence(int32 deviation, int32 length, bool random) :
+    deviation_ (deviation),
+    length_    (length),
+    random_    (random),
+    index_     (0),
+    lfsr_      (LFSR_SEED){
+  }
+
+  /**
+   * Destructor.
+   */
+ ~PwmDitherSequence(){}
+
+  /**
+   * Returns the offset of next period.
+   *
+   * @return the offset in time-base clocks.
+   */
+  int32 next()
+  {
+    float32 pos;
+    if(!random_)
+    {
+      // The position is raised from -1 to 1 in the first half, and lowered back in the second one
+      float32 part = static_cast<float32>(index_) / static_cast<float32>(length_);
+      pos = part < 0.5f ? 4.0f * part - 1.0f : 3.0f - 4.0f * part;
+    }
+    else
+    {
+      uint16 lsb = lfsr_ & 0x1;
+      lfsr_ = lfsr_ >> 1;
+      if(lsb != 0) lfsr_ ^= LFSR_TAPS;
+      pos = static_cast<float32>( static_cast<int32>(lfsr_) - 0x8000 ) / 32768.0f;
+    }
+    index_ = index_ + 1 < length_ ? index_ + 1 : 0;
+    return static_cast<int32>( static_cast<float32>(deviation_) * pos + (pos < 0.0f ? -0.5f : 0.5f) );
+  }
+
+  /**
+   * Returns a compare value of a dithered period.
+   *
+   * The method does the same operations as the fast duty updating of the PWM driver 
+   * with the scaling of the dithered period.
+   *
+   * @param period count of time-base clocks of the dithered period.
+   * @param duty   a duty in Q15 format, where 0x8000 and greater values are 100%.
+   * @param zero   the compare value of zero duty of the dithered period.
+   * @param sign   minus one for the inverse compare, or zero.
+   * @return the compare value.
+   */
+  static uint16 getCompare(uint32 period, uint16 duty, int32 zero, int32 sign)
+  {
+    int32 over = static_cast<int32>(duty) - 0x8000;
+    over &= ~(over >> 31);
+    uint32 limited = static_cast<uint32>(duty) - static_cast<uint32>(over);
+    int32 value = static_cast<int32>(period * limited >> 15);
+    value = zero + ((value ^ sign) - sign);
+    value &= ~(value >> 31);
+    return static_cast<uint16>(value);
+  }
+
+private:
+
+  /**
+   * The initial value of the linear feedback shift register.
+   */
+  static const uint16 LFSR_SEED = 0xace1;
+
+  /**
+   * The taps of the maximal length 16-bit Galois linear feedback shift register.
+   */
+  static const uint16 LFSR_TAPS = 0xb400;
+
+  /**
+   * Max offset of a period in time-base clocks.
+   */
+  int32 deviation_;
+
+  /**
+   * Number of periods in the sequence.
+   */
+  int32 length_;
+
+  /**
+   * The offsets are pseudo-random.
+   */
+  bool random_;
+
+  /**
+   * The index of next period in the sequence.
+   */
+  int32 index_;
+
+  /**
+   * The linear feedback shift register.
+   */
+  uint16 lfsr_;
+
+};
+#endif // DRIVER_PWM_DITHER_SEQUENCE_HPP_
@@ -0,0 +1,97 @@
+/**
+ * Three-phase space vector modulation.
+ *
+ * The modulation calculates the duties of three phases of a bridge for a voltage reference
+ * in the stationary frame. It uses target types only, thus it is shared by the space vector
+ * modulator of the PWM driver and the host test of the modulation.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_PWM_VECTOR_MODULATION_HPP_
+#define DRIVER_PWM_VECTOR_MODULATION_HPP_
+
+#include "driver.Types.hpp"
+
+class PwmVectorModulation
+{
+
+public:
+
+  /**
+   * Error defenition.
+   */
+  static const int32 ERROR = -1;
+
+  /**
+   * Number of the modulation phases.
+   */
+  static const int32 PHASES_NUMBER = 3;
+
+  /**
+   * Calculates the duties of the phases.
+   *
+   * The sector is selected by the order of the phase voltages, and the dwell times 
+   * of two active vectors are centered by splitting the zero vector time equally. 
+   * A reference out of the linear range is limited to the hexagon boundary keeping its angle.
+   *
+   * @param alpha an alpha component normalized to the DC link voltage.
+   * @param beta  a beta component normalized to the DC link voltage.
+   * @param duty  an array of PHASES_NUMBER duties in Q15 format to be filled.
+   * @return the sector from 1 to 6.
+   */
+  static int32 modulate(float32 alpha, float32 beta, uint16* duty)
+  {
+    // The sectors indexed by the phases with max and min voltages
+    static const int32 sector[PHASES_NUMBER][PHASES_NUMBER] = {
+      {ERROR, 6, 1},
+      {3, ERROR, 2},
+      {4, 5, ERROR}
+    };
+    // Half of square root of three
+    const float32 halfSqrt3 = 0.8660254f;
+    // The inverse Clarke transformation to the phase voltages
+    float32 volt[PHASES_NUMBER];
+    volt[0] = alpha;
+    volt[1] = halfSqrt3 * beta - 0.5f * alpha;
+    volt[2] = 0.0f - halfSqrt3 * beta - 0.5f * alpha;
+    // The sector is defined by the phases with max and min voltages
+    int32 max = volt[0] >= volt[1] ? 0 : 1;
+    if(volt[2] > volt[max]) max = 2;
+    int32 min = volt[0] < volt[1] ? 0 : 1;
+    if(volt[2] < volt[min]) min = 2;
+    int32 mid = PHASES_NUMBER - max - min;
+    // The dwell times of two active vectors in the PWM period
+    float32 time1 = volt[max] - volt[mid];
+    float32 time2 = volt[mid] - volt[min];
+    float32 sum = time1 + time2;
+    if(sum > 1.0f)
+    {
+      // Limit the reference to the hexagon boundary keeping its angle
+      time1 = time1 / sum;
+      time2 = time2 / sum;
+      sum = 1.0f;
+    }
+    float32 half0 = 0.5f * (1.0f - sum);
+    duty[max] = getDuty(half0 + sum);
+    duty[mid] = getDuty(half0 + time2);
+    duty[min] = getDuty(half0);
+    return sector[max][min];
+  }
+
+private:
+
+  /**
+   * Returns a duty of a part of the PWM period.
+   *
+   * @param part a part of the PWM period from 0.0 to 1.0.
+   * @return the duty in Q15 format.
+   */
+  static uint16 getDuty(float32 part)
+  {
+    if(part <= 0.0f) return 0;
+    if(part >= 1.0f) return 0x8000;
+    return static_cast<uint16>(part * 32768.0f);
+  }
+
+};
+#endif // DRIVER_PWM_VECTOR_MODULATION_HPP_
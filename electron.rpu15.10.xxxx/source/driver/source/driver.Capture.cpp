@@ -0,0 +1,42 @@
+/** 
+ * Enhanced Capture driver factory.
+ * 
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#include "driver.Capture.hpp"
+#include "driver.CaptureController.hpp"
+
+/**
+ * Returns the driver resource interface.
+ *
+ * @param number   a number of an eCAP module from 1 to 6.
+ * @param capacity a number of the measured periods in the ring buffer.
+ * @return the eCAP module driver interface, or null if error has been occurred.
+ */
+::Capture* Capture::create(int32 number, int32 capacity)
+{
+  CaptureController* res = new CaptureController(number - 1, capacity);
+  if(res == NULL) return NULL;
+  if(res->isConstructed()) return res;
+  delete res;
+  return NULL;
+}
+
+/**
+ * Initializes the driver.
+ *
+ * @param sourceClock the CPU oscillator source clock in Hz.
+ * @return true if no errors.
+ */
+bool Capture::init(int32 sourceClock)  
+{
+  return CaptureController::init(sourceClock);
+}
+
+/**
+ * Deinitializes the driver.
+ */
+void Capture::deinit()
+{
+  CaptureController::deinit();
+}
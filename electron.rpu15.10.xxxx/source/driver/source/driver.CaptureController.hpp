@@ -0,0 +1,751 @@
+/**
+ * TI TMS320F2833x DSP Enhanced Capture controller.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_CAPTURE_CONTROLLER_HPP_
+#define DRIVER_CAPTURE_CONTROLLER_HPP_
+
+#include "driver.Object.hpp"
+#include "driver.Capture.hpp"
+#include "driver.CaptureRegister.hpp"
+#include "driver.System.hpp"
+#include "driver.SystemRegister.hpp"
+#include "driver.GpioRegister.hpp"
+#include "driver.Mutex.hpp"
+#include "driver.Interrupt.hpp"
+#include "driver.InterruptTask.hpp"
+
+class CaptureController : public ::Object, public ::Capture, public ::InterruptTask
+{
+  typedef ::Object                        Parent;
+  typedef ::CaptureRegister::Ecctl1::Val  Ecctl1;
+  typedef ::CaptureRegister::Ecctl2::Val  Ecctl2;
+
+public:
+
+  /**
+   * Constructor of the driver resource.
+   *
+   * @param index    an available index of eCAP module.
+   * @param capacity a number of the measured periods in the ring buffer.
+   */
+  CaptureController(int32 index, int32 capacity) : Parent(), ::InterruptTask(),
+    regCap_     (NULL),
+    int_        (NULL),
+    index_      (index),
+    length_     (capacity + 1),
+    buffer_     (NULL),
+    head_       (0),
+    tail_       (0),
+    lost_       (0),
+    isLast_     (false),
+    ref_        (NULL),
+    channel_    (0),
+    tolerance_  (0.0f),
+    mismatches_ (0),
+    handler_    (NULL),
+    mutex_      (){
+    last_.period = 0;
+    last_.width = 0;
+    setConstruct( construct() );
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~CaptureController()
+  {
+    if(isConstructed())
+    {
+      stop();
+      if(mutex_.drv.lock())
+      {
+        clockOn(false);
+        lock_[index_] = false;
+        mutex_.drv.unlock();
+      }
+    }
+    if(buffer_ != NULL) delete[] buffer_;
+  }
+
+  /**
+   * Starts capturing the edges of the signal.
+   *
+   * @return true if capturing has been started successfully.
+   */
+  virtual bool start()
+  {
+    if(!isConstructed()) return false;
+    if(!mutex_.res.lock()) return false;
+    if(int_ == NULL)
+    {
+      int_ = Interrupt::create(*this, getSource());
+      if(int_ == NULL) return mutex_.res.unlock(false);
+    }
+    int_->disable();
+    regCap_->eceint.val = 0x0000;
+    regCap_->ecclr.val = 0x00ff;
+    // One interrupt is generated on the fourth edge, and the module is stopped until it is re-armed
+    regCap_->eceint.bit.cevt4 = 1;
+    regCap_->ecctl2.bit.rearm = 1;
+    int_->enable(true);
+    return mutex_.res.unlock(true);
+  }
+
+  /**
+   * Stops capturing.
+   */
+  virtual void stop()
+  {
+    if(!isConstructed()) return;
+    if(!mutex_.res.lock()) return;
+    regCap_->eceint.val = 0x0000;
+    regCap_->ecclr.val = 0x00ff;
+    if(int_ != NULL)
+    {
+      int_->disable();
+      delete int_;
+    }
+    int_ = NULL;
+    mutex_.res.unlock();
+  }
+
+  /**
+   * Reads the oldest measured period from the ring buffer.
+   *
+   * @param sample a period to be filled.
+   * @return true if the period has been read, or false if the buffer is empty.
+   */
+  virtual bool read(Sample& sample)
+  {
+    if(!isConstructed()) return false;
+    // The head is changed only here, and the tail is changed only by the interrupt
+    int32 head = head_;
+    if(head == tail_) return false;
+    sample = buffer_[head];
+    head_ = head + 1 < length_ ? head + 1 : 0;
+    return true;
+  }
+
+  /**
+   * Returns a number of the measured periods in the ring buffer.
+   *
+   * @return the number of periods, or ERROR if error has been occurred.
+   */
+  virtual int32 getSamplesNumber() const
+  {
+    if(!isConstructed()) return ERROR;
+    int32 num = tail_ - head_;
+    return num >= 0 ? num : num + length_;
+  }
+
+  /**
+   * Returns a number of the measured periods, which have been lost as the buffer was full.
+   *
+   * @return the number of periods, or ERROR if error has been occurred.
+   */
+  virtual int32 getLostNumber() const
+  {
+    return isConstructed() ? lost_ : ERROR;
+  }
+
+  /**
+   * Returns the last measured period.
+   *
+   * @param sample a period to be filled.
+   * @return true if a period has been measured.
+   */
+  virtual bool getLast(Sample& sample) const
+  {
+    if(!isConstructed()) return false;
+    bool is = Interrupt::globalDisable();
+    bool res = isLast_;
+    sample.period = last_.period;
+    sample.width = last_.width;
+    Interrupt::globalEnable(is);
+    return res;
+  }
+
+  /**
+   * Returns the signal frequency of the last measured period.
+   *
+   * @return the frequency in Hz, or ERROR if no period has been measured.
+   */
+  virtual float32 getFrequency() const
+  {
+    Sample sample;
+    if(!getLast(sample) || sample.period == 0) return ERROR;
+    return static_cast<float32>(sysclk_) / static_cast<float32>(sample.period);
+  }
+
+  /**
+   * Returns the signal duty of the last measured period.
+   *
+   * @return the duty in percentages, or ERROR if no period has been measured.
+   */
+  virtual float32 getDuty() const
+  {
+    Sample sample;
+    if(!getLast(sample) || sample.period == 0) return ERROR;
+    return static_cast<float32>(sample.width) * 100.0f / static_cast<float32>(sample.period);
+  }
+
+  /**
+   * Returns the dead-band time between the signal and its complementary signal.
+   *
+   * @param complement a module capturing the complementary signal.
+   * @return the dead-band time in ns, or ERROR if error has been occurred.
+   */
+  virtual float32 getDeadTime(const ::Capture& complement) const
+  {
+    Sample sig, comp;
+    if(!getLast(sig) || !complement.getLast(comp)) return ERROR;
+    // The period of the signal is the same for both signals
+    int32 low = static_cast<int32>(sig.period - sig.width - comp.width);
+    if(low < 0) return ERROR;
+    // The low time is the sum of two delays, thus a half of it is converted to ns
+    return static_cast<float32>(low) * 500000000.0f / static_cast<float32>(sysclk_);
+  }
+
+  /**
+   * Returns the time-stamp counter clock frequency.
+   *
+   * @return the clock frequency in Hz, or ERROR if error has been occurred.
+   */
+  virtual int32 getClockFrequency() const
+  {
+    return isConstructed() ? sysclk_ : ERROR;
+  }
+
+  /**
+   * Sets a PWM module channel which generates the captured signal.
+   *
+   * @param pwm       a PWM module.
+   * @param channel   a channel number of the PWM module.
+   * @param tolerance max deviation of the period and the pulse width in percentages of the period.
+   * @return true if the reference has been set successfully.
+   */
+  virtual bool setReference(::Pwm& pwm, int32 channel, float32 tolerance)
+  {
+    if(!isConstructed()) return false;
+    if(channel < 0 || channel >= pwm.getChannelsNumber()) return false;
+    if(tolerance <= 0.0f || tolerance >= 100.0f) return false;
+    bool is = Interrupt::globalDisable();
+    ref_ = &pwm;
+    channel_ = channel;
+    tolerance_ = tolerance / 100.0f;
+    mismatches_ = 0;
+    Interrupt::globalEnable(is);
+    return true;
+  }
+
+  /**
+   * Resets the PWM module reference.
+   */
+  virtual void resetReference()
+  {
+    ref_ = NULL;
+  }
+
+  /**
+   * Returns a number of the measured periods, which mismatch the reference.
+   *
+   * @return the number of periods, or ERROR if error has been occurred.
+   */
+  virtual int32 getMismatchesNumber() const
+  {
+    return isConstructed() ? mismatches_ : ERROR;
+  }
+
+  /**
+   * Resets the number of mismatching periods.
+   */
+  virtual void resetMismatches()
+  {
+    mismatches_ = 0;
+  }
+
+  /**
+   * Sets a mismatch handler.
+   *
+   * @param handler a user handler.
+   * @return true if the handler has been set successfully.
+   */
+  virtual bool setHandler(::InterruptTask& handler)
+  {
+    if(!isConstructed()) return false;
+    handler_ = &handler;
+    return true;
+  }
+
+  /**
+   * Resets the mismatch handler.
+   */
+  virtual void resetHandler()
+  {
+    handler_ = NULL;
+  }
+
+  /**
+   * Puts the measured period to the ring buffer.
+   *
+   * The method is called by the interrupt of the fourth captured edge.
+   */
+  virtual void handler()
+  {
+    // The edges are rising, falling, rising and falling in the absolute time-stamps,
+    // and the unsigned differences are correct if the counter has been wrapped
+    uint32 rise = regCap_->cap1.val;
+    Sample sample;
+    sample.width = regCap_->cap2.val - rise;
+    sample.period = regCap_->cap3.val - rise;
+    regCap_->ecclr.val = 0x00ff;
+    regCap_->ecctl2.bit.rearm = 1;
+    last_ = sample;
+    isLast_ = true;
+    int32 tail = tail_;
+    int32 next = tail + 1 < length_ ? tail + 1 : 0;
+    if(next != head_)
+    {
+      buffer_[tail] = sample;
+      tail_ = next;
+    }
+    else
+    {
+      lost_++;
+    }
+    if(ref_ != NULL && !isMatched(sample))
+    {
+      mismatches_++;
+      if(handler_ != NULL) handler_->handler();
+    }
+  }
+
+  /**
+   * Tests if this object has been constructed.
+   *
+   * @return true if object has been constructed successfully.
+   */
+  virtual bool isConstructed() const
+  {
+    return this->Parent::isConstructed();
+  }
+
+  /**
+   * Initializes the driver.
+   *
+   * @param sourceClock the CPU oscillator source clock in Hz.
+   * @return true if no errors.
+   */
+  static bool init(int32 sourceClock)
+  {
+    isInitialized_ = 0;
+    for(int32 i=0; i<RESOURCES_NUMBER; i++) lock_[i] = false;
+    // Create the driver Mutex
+    drvMutex_ = new Mutex();
+    if(drvMutex_ == NULL || !drvMutex_->isConstructed() ) return false;
+    // Create the CPU registers maps
+    regSys_ = new (SystemRegister::ADDRESS) SystemRegister();
+    regGpio_ = new (GpioRegister::ADDRESS) GpioRegister();
+    sysclk_ = getCpuClock(sourceClock);
+    if(sysclk_ <= 0) return false;
+    isInitialized_ = IS_INITIALIZED;
+    return true;
+  }
+
+  /**
+   * Deinitialization.
+   */
+  static void deinit()
+  {
+    sysclk_ = 0;
+    regSys_ = NULL;
+    regGpio_ = NULL;
+    isInitialized_ = 0;
+    if(drvMutex_ != NULL) delete drvMutex_;
+    for(int32 i=0; i<RESOURCES_NUMBER; i++) lock_[i] = false;
+  }
+
+private:
+
+  /**
+   * Constructor.
+   *
+   * @return boolean result.
+   */
+  bool construct()
+  {
+    if(isInitialized_ != IS_INITIALIZED) return false;
+    if(index_ < 0 || index_ >= RESOURCES_NUMBER) return false;
+    if(length_ < 2 || length_ > CAPACITY_MAX + 1) return false;
+    if(!mutex_.drv.isConstructed()) return false;
+    if(!mutex_.res.isConstructed()) return false;
+    buffer_ = new Sample[length_];
+    if(buffer_ == NULL) return false;
+    if(!mutex_.drv.lock()) return false;
+    if(lock_[index_] == true) return mutex_.drv.unlock(false);
+    regCap_ = new (getAddress(index_)) CaptureRegister();
+    clockOn(true);
+    if(!setPin())
+    {
+      clockOn(false);
+      return mutex_.drv.unlock(false);
+    }
+    regCap_->eceint.val = 0x0000;
+    regCap_->ecclr.val = 0x00ff;
+    regCap_->ecctl2.bit.tsctrstop = 0;
+    // Capture two periods by the absolute time-stamps
+    regCap_->ecctl1.bit.cap1pol = Ecctl1::RISING_EDGE;
+    regCap_->ecctl1.bit.cap2pol = Ecctl1::FALLING_EDGE;
+    regCap_->ecctl1.bit.cap3pol = Ecctl1::RISING_EDGE;
+    regCap_->ecctl1.bit.cap4pol = Ecctl1::FALLING_EDGE;
+    regCap_->ecctl1.bit.ctrrst1 = Ecctl1::ABSOLUTE;
+    regCap_->ecctl1.bit.ctrrst2 = Ecctl1::ABSOLUTE;
+    regCap_->ecctl1.bit.ctrrst3 = Ecctl1::ABSOLUTE;
+    regCap_->ecctl1.bit.ctrrst4 = Ecctl1::ABSOLUTE;
+    regCap_->ecctl1.bit.prescale = 0;
+    regCap_->ecctl1.bit.freeSoft = Ecctl1::RUN_FREE;
+    regCap_->ecctl1.bit.caplden = 1;
+    // The module is stopped after four edges, and it is re-armed by the interrupt
+    regCap_->ecctl2.bit.capApwm = Ecctl2::CAPTURE;
+    regCap_->ecctl2.bit.contOnesht = Ecctl2::ONE_SHOT;
+    regCap_->ecctl2.bit.stopWrap = Ecctl2::WRAP_CEVT4;
+    regCap_->ecctl2.bit.synciEn = 0;
+    regCap_->ecctl2.bit.syncoSel = Ecctl2::SYNC_DISABLE;
+    regCap_->ecctl2.bit.tsctrstop = 1;
+    lock_[index_] = true;
+    return mutex_.drv.unlock(true);
+  }
+
+  /**
+   * Tests if a measured period matches the reference.
+   *
+   * @param sample a measured period.
+   * @return true if the period matches the task of the reference PWM module.
+   */
+  bool isMatched(const Sample& sample) const
+  {
+    int32 freq = ref_->getSignalFrequency(true);
+    int32 frac = ref_->getSignalFraction(true);
+    float32 duty = ref_->getDuty(channel_, true);
+    if(freq <= 0 || frac == ERROR || duty == ERROR) return false;
+    // The expected period in the time-stamp counter clocks
+    float32 period = static_cast<float32>(sysclk_) / ( static_cast<float32>(freq) + static_cast<float32>(frac) / 65536.0f );
+    float32 width = period * duty / 100.0f;
+    float32 limit = period * tolerance_;
+    float32 dev = static_cast<float32>(sample.period) - period;
+    if(dev > limit || dev < 0.0f - limit) return false;
+    dev = static_cast<float32>(sample.width) - width;
+    if(dev > limit || dev < 0.0f - limit) return false;
+    return true;
+  }
+
+  /**
+   * Configures the GPIO pin of the module as the capture input.
+   *
+   * @return true if the pin has been configured.
+   */
+  bool setPin()
+  {
+    bool res = true;
+    System::eallow();
+    switch(index_)
+    {
+      // Enable the pullup, synchronous input, and ECAP1-ECAP4 pins function
+      case  0: regGpio_->gpapud.bit.gpio24 = 0; regGpio_->gpaqsel2.bit.gpio24 = 0; regGpio_->gpamux2.bit.gpio24 = 1; break;
+      case  1: regGpio_->gpapud.bit.gpio25 = 0; regGpio_->gpaqsel2.bit.gpio25 = 0; regGpio_->gpamux2.bit.gpio25 = 1; break;
+      case  2: regGpio_->gpapud.bit.gpio26 = 0; regGpio_->gpaqsel2.bit.gpio26 = 0; regGpio_->gpamux2.bit.gpio26 = 1; break;
+      case  3: regGpio_->gpapud.bit.gpio27 = 0; regGpio_->gpaqsel2.bit.gpio27 = 0; regGpio_->gpamux2.bit.gpio27 = 1; break;
+      // Enable the pullup, synchronous input, and ECAP5-ECAP6 pins function
+      case  4: regGpio_->gpbpud.bit.gpio48 = 0; regGpio_->gpbqsel2.bit.gpio48 = 0; regGpio_->gpbmux2.bit.gpio48 = 1; break;
+      case  5: regGpio_->gpbpud.bit.gpio49 = 0; regGpio_->gpbqsel2.bit.gpio49 = 0; regGpio_->gpbmux2.bit.gpio49 = 1; break;
+      default: res = false;
+    }
+    System::dallow();
+    return res;
+  }
+
+  /**
+   * Turns the eCAP clock on.
+   *
+   * @param value true to turn the clock on.
+   */
+  void clockOn(bool value)
+  {
+    uint16 en = value ? 1 : 0;
+    System::eallow();
+    switch(index_)
+    {
+      case  0: regSys_->pclkcr1.bit.ecap1enclk = en; break;
+      case  1: regSys_->pclkcr1.bit.ecap2enclk = en; break;
+      case  2: regSys_->pclkcr1.bit.ecap3enclk = en; break;
+      case  3: regSys_->pclkcr1.bit.ecap4enclk = en; break;
+      case  4: regSys_->pclkcr1.bit.ecap5enclk = en; break;
+      case  5: regSys_->pclkcr1.bit.ecap6enclk = en; break;
+      default: break;
+    }
+    System::dallow();
+  }
+
+  /**
+   * Returns the interrupt source of the module.
+   *
+   * @return the ECAPx_INT interrupt source.
+   */
+  int32 getSource() const
+  {
+    // The interrupts are in the PIE group 4
+    return index_ << 4 | 0x0003;
+  }
+
+  /**
+   * Returns an address of the module registers.
+   *
+   * @param index an index of the module.
+   * @return the address, or zero if the index is wrong.
+   */
+  static uint32 getAddress(int32 index)
+  {
+    switch(index)
+    {
+      case  0: return CaptureRegister::ADDRESS0;
+      case  1: return CaptureRegister::ADDRESS1;
+      case  2: return CaptureRegister::ADDRESS2;
+      case  3: return CaptureRegister::ADDRESS3;
+      case  4: return CaptureRegister::ADDRESS4;
+      case  5: return CaptureRegister::ADDRESS5;
+      default: return 0;
+    }
+  }
+
+  /**
+   * Returns SYSCLK based on OSCCLK.
+   *
+   * @param sourceClock source clock in Hz.
+   * @return CPU clock in Hz.
+   */
+  static int32 getCpuClock(int32 sourceClock)
+  {
+    int32 sysclk, m, d;
+    if(regSys_ == NULL) return ERROR;
+    // Test the oscillator is not off
+    if(regSys_->pllsts.bit.oscoff == 1) return false;
+    // Test the PLL is set correctly
+    if(regSys_->pllsts.bit.plloff == 1 && regSys_->pllcr.bit.div > 0) return false;
+    // Calculate the CPU frequency
+    m = regSys_->pllcr.bit.div != 0 ? regSys_->pllcr.bit.div : 1;
+    switch(regSys_->pllsts.bit.divsel)
+    {
+      case  0:
+      case  1: d = 4; break;
+      case  2: d = 2; break;
+      default: return false;
+    }
+    sysclk = sourceClock / d * m;
+    return sysclk > 0 ? sysclk : ERROR;
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  CaptureController(const CaptureController& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  CaptureController& operator =(const CaptureController& obj);
+
+  /**
+   * Mutexs of the driver and the resource.
+   */
+  struct Mutexs
+  {
+    /**
+     * Constructor.
+     */
+    Mutexs() :
+      drv (*drvMutex_),
+      res (*drvMutex_){
+    }
+
+    /**
+     * Destructor.
+     */
+   ~Mutexs(){}
+
+    /**
+     * The driver Mutex.
+     */
+    Mutex& drv;
+
+    /**
+     * The resource Mutex.
+     */
+    Mutex& res;
+
+  };
+
+  /**
+   * Number of eCAP modules.
+   */
+  static const int32 RESOURCES_NUMBER = 6;
+
+  /**
+   * Max number of the measured periods in the ring buffer.
+   */
+  static const int32 CAPACITY_MAX = 0x1000;
+
+  /**
+   * eCAP driver initialized falg value.
+   */
+  static const int32 IS_INITIALIZED = 0x24a1c7e3;
+
+  /**
+   * Locked eCAP flags (no boot).
+   */
+  static bool lock_[RESOURCES_NUMBER];
+
+  /**
+   * CPU clock in Hz (no boot).
+   */
+  static int32 sysclk_;
+
+  /**
+   * System Control Registers (no boot).
+   */
+  static SystemRegister* regSys_;
+
+  /**
+   * General Purpose Input/Output Registers (no boot).
+   */
+  static GpioRegister* regGpio_;
+
+  /**
+   * Mutex of this driver (no boot).
+   */
+  static Mutex* drvMutex_;
+
+  /**
+   * Driver has been initialized successfully (no boot).
+   */
+  static int32 isInitialized_;
+
+  /**
+   * Enhanced Capture Module Registers.
+   */
+  CaptureRegister* regCap_;
+
+  /**
+   * The capture interrupt.
+   */
+  ::Interrupt* int_;
+
+  /**
+   * The index of eCAP resource.
+   */
+  int32 index_;
+
+  /**
+   * The ring buffer length, which is one more than its capacity.
+   */
+  int32 length_;
+
+  /**
+   * The ring buffer of the measured periods.
+   */
+  Sample* buffer_;
+
+  /**
+   * The index of the oldest measured period.
+   */
+  volatile int32 head_;
+
+  /**
+   * The index of next measured period.
+   */
+  volatile int32 tail_;
+
+  /**
+   * Number of the lost periods.
+   */
+  volatile int32 lost_;
+
+  /**
+   * The last measured period.
+   */
+  Sample last_;
+
+  /**
+   * A period has been measured.
+   */
+  volatile bool isLast_;
+
+  /**
+   * The reference PWM module.
+   */
+  ::Pwm* ref_;
+
+  /**
+   * The channel number of the reference PWM module.
+   */
+  int32 channel_;
+
+  /**
+   * The reference tolerance part of the period.
+   */
+  float32 tolerance_;
+
+  /**
+   * Number of the mismatching periods.
+   */
+  volatile int32 mismatches_;
+
+  /**
+   * The mismatch handler.
+   */
+  ::InterruptTask* handler_;
+
+  /**
+   * The driver and the resource mutexs.
+   */
+  Mutexs mutex_;
+
+};
+
+/**
+ * Locked eCAP flags (no boot).
+ */
+bool CaptureController::lock_[CaptureController::RESOURCES_NUMBER];
+
+/**
+ * CPU clock in Hz (no boot).
+ */
+int32 CaptureController::sysclk_;
+
+/**
+ * System Control Registers (no boot).
+ */
+SystemRegister* CaptureController::regSys_;
+
+/**
+ * General Purpose Input/Output Registers (no boot).
+ */
+GpioRegister* CaptureController::regGpio_;
+
+/**
+ * Mutex of this driver (no boot).
+ */
+Mutex* CaptureController::drvMutex_;
+
+/**
+ * Driver has been initialized successfully (no boot).
+ */
+int32 CaptureController::isInitialized_;
+
+#endif // DRIVER_CAPTURE_CONTROLLER_HPP_
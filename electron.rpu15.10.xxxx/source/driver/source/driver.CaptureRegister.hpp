@@ -0,0 +1,315 @@
+/**
+ * TI TMS320F2833x Enhanced Capture Module registers.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_CAPTURE_REGISTER_HPP_
+#define DRIVER_CAPTURE_REGISTER_HPP_
+
+#include "driver.Types.hpp"
+
+struct CaptureRegister
+{
+
+public:
+
+  /**
+   * Default configuration addresses in PF1.
+   */
+  static const uint32 ADDRESS0 = 0x00006A00;
+  static const uint32 ADDRESS1 = 0x00006A20;
+  static const uint32 ADDRESS2 = 0x00006A40;
+  static const uint32 ADDRESS3 = 0x00006A60;
+  static const uint32 ADDRESS4 = 0x00006A80;
+  static const uint32 ADDRESS5 = 0x00006AA0;
+
+  /**
+   * Constructor.
+   */
+  CaptureRegister() :
+    tsctr  (), // ALLOWED
+    ctrphs (), // ALLOWED
+    cap1   (), // ALLOWED
+    cap2   (), // ALLOWED
+    cap3   (), // ALLOWED
+    cap4   (), // ALLOWED
+    ecctl1 (), // ALLOWED
+    ecctl2 (), // ALLOWED
+    eceint (), // ALLOWED
+    ecflg  (), // ALLOWED
+    ecclr  (), // ALLOWED
+    ecfrc  (){ // ALLOWED
+  }
+
+  /**
+   * Destructor.
+   */
+ ~CaptureRegister(){}
+
+  /**
+   * Operator new.
+   *
+   * @param size unused.
+   * @param ptr  address of memory.
+   * @return address of memory.
+   */
+  void* operator new(size_t, uint32 ptr)
+  {
+    return reinterpret_cast<void*>(ptr);
+  }
+
+  // NOT EALLOW PROTECTED
+
+  /**
+   * Time-Stamp Counter.
+   */
+  union Tsctr
+  {
+    Tsctr(){}
+    Tsctr(uint32 v){val = v;}
+   ~Tsctr(){}
+
+    uint32 val;
+  } tsctr;
+
+  /**
+   * Counter Phase Control Register.
+   */
+  union Ctrphs
+  {
+    Ctrphs(){}
+    Ctrphs(uint32 v){val = v;}
+   ~Ctrphs(){}
+
+    uint32 val;
+  } ctrphs;
+
+  /**
+   * Capture 1 Register.
+   */
+  union Cap1
+  {
+    Cap1(){}
+    Cap1(uint32 v){val = v;}
+   ~Cap1(){}
+
+    uint32 val;
+  } cap1;
+
+  /**
+   * Capture 2 Register.
+   */
+  union Cap2
+  {
+    Cap2(){}
+    Cap2(uint32 v){val = v;}
+   ~Cap2(){}
+
+    uint32 val;
+  } cap2;
+
+  /**
+   * Capture 3 Register.
+   */
+  union Cap3
+  {
+    Cap3(){}
+    Cap3(uint32 v){val = v;}
+   ~Cap3(){}
+
+    uint32 val;
+  } cap3;
+
+  /**
+   * Capture 4 Register.
+   */
+  union Cap4
+  {
+    Cap4(){}
+    Cap4(uint32 v){val = v;}
+   ~Cap4(){}
+
+    uint32 val;
+  } cap4;
+
+private:
+
+  uint16 space0_[8];
+
+public:
+
+  /**
+   * Capture Control Register 1.
+   */
+  union Ecctl1
+  {
+    Ecctl1(){}
+    Ecctl1(uint16 v){val = v;}
+   ~Ecctl1(){}
+
+    uint16 val;
+    struct Val
+    {
+      // CAPxPOL bits
+      static const uint16 RISING_EDGE  = 0x0; // default on reset
+      static const uint16 FALLING_EDGE = 0x1;
+      // CTRRSTx bits
+      static const uint16 ABSOLUTE = 0x0; // default on reset
+      static const uint16 DELTA    = 0x1;
+      // FREE_SOFT bits
+      static const uint16 STOP_IMMEDIATELY = 0x0; // default on reset
+      static const uint16 RUN_FREE         = 0x2;
+
+      uint16 cap1pol   : 1;
+      uint16 ctrrst1   : 1;
+      uint16 cap2pol   : 1;
+      uint16 ctrrst2   : 1;
+      uint16 cap3pol   : 1;
+      uint16 ctrrst3   : 1;
+      uint16 cap4pol   : 1;
+      uint16 ctrrst4   : 1;
+      uint16 caplden   : 1;
+      uint16 prescale  : 5;
+      uint16 freeSoft  : 2;
+    } bit;
+  } ecctl1;
+
+  /**
+   * Capture Control Register 2.
+   */
+  union Ecctl2
+  {
+    Ecctl2(){}
+    Ecctl2(uint16 v){val = v;}
+   ~Ecctl2(){}
+
+    uint16 val;
+    struct Val
+    {
+      // CONT_ONESHT bits
+      static const uint16 CONTINUOUS = 0x0; // default on reset
+      static const uint16 ONE_SHOT   = 0x1;
+      // STOP_WRAP bits
+      static const uint16 WRAP_CEVT1 = 0x0;
+      static const uint16 WRAP_CEVT2 = 0x1;
+      static const uint16 WRAP_CEVT3 = 0x2;
+      static const uint16 WRAP_CEVT4 = 0x3; // default on reset
+      // SYNCO_SEL bits
+      static const uint16 SYNC_IN      = 0x0; // default on reset
+      static const uint16 CTR_PRD      = 0x1;
+      static const uint16 SYNC_DISABLE = 0x2;
+      // CAP_APWM bits
+      static const uint16 CAPTURE = 0x0; // default on reset
+      static const uint16 APWM    = 0x1;
+
+      uint16 contOnesht : 1;
+      uint16 stopWrap   : 2;
+      uint16 rearm      : 1;
+      uint16 tsctrstop  : 1;
+      uint16 synciEn    : 1;
+      uint16 syncoSel   : 2;
+      uint16 swsync     : 1;
+      uint16 capApwm    : 1;
+      uint16 apwmpol    : 1;
+      uint16            : 5;
+    } bit;
+  } ecctl2;
+
+  /**
+   * Capture Interrupt Enable Register.
+   */
+  union Eceint
+  {
+    Eceint(){}
+    Eceint(uint16 v){val = v;}
+   ~Eceint(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16           : 1;
+      uint16 cevt1     : 1;
+      uint16 cevt2     : 1;
+      uint16 cevt3     : 1;
+      uint16 cevt4     : 1;
+      uint16 ctrovf    : 1;
+      uint16 ctrEqPrd  : 1;
+      uint16 ctrEqCmp  : 1;
+      uint16           : 8;
+    } bit;
+  } eceint;
+
+  /**
+   * Capture Interrupt Flag Register.
+   */
+  union Ecflg
+  {
+    Ecflg(){}
+    Ecflg(uint16 v){val = v;}
+   ~Ecflg(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16 intb      : 1;
+      uint16 cevt1     : 1;
+      uint16 cevt2     : 1;
+      uint16 cevt3     : 1;
+      uint16 cevt4     : 1;
+      uint16 ctrovf    : 1;
+      uint16 ctrEqPrd  : 1;
+      uint16 ctrEqCmp  : 1;
+      uint16           : 8;
+    } bit;
+  } ecflg;
+
+  /**
+   * Capture Interrupt Clear Register.
+   */
+  union Ecclr
+  {
+    Ecclr(){}
+    Ecclr(uint16 v){val = v;}
+   ~Ecclr(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16 intb      : 1;
+      uint16 cevt1     : 1;
+      uint16 cevt2     : 1;
+      uint16 cevt3     : 1;
+      uint16 cevt4     : 1;
+      uint16 ctrovf    : 1;
+      uint16 ctrEqPrd  : 1;
+      uint16 ctrEqCmp  : 1;
+      uint16           : 8;
+    } bit;
+  } ecclr;
+
+  /**
+   * Capture Interrupt Force Register.
+   */
+  union Ecfrc
+  {
+    Ecfrc(){}
+    Ecfrc(uint16 v){val = v;}
+   ~Ecfrc(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16           : 1;
+      uint16 cevt1     : 1;
+      uint16 cevt2     : 1;
+      uint16 cevt3     : 1;
+      uint16 cevt4     : 1;
+      uint16 ctrovf    : 1;
+      uint16 ctrEqPrd  : 1;
+      uint16 ctrEqCmp  : 1;
+      uint16           : 8;
+    } bit;
+  } ecfrc;
+
+};
+#endif // DRIVER_CAPTURE_REGISTER_HPP_
@@ -0,0 +1,350 @@
+/**
+ * TI TMS320F2833x Direct Memory Access registers.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_DMA_REGISTER_HPP_
+#define DRIVER_DMA_REGISTER_HPP_
+
+#include "driver.Types.hpp"
+
+/**
+ * Direct Memory Access registers.
+ */
+struct DmaRegister
+{
+
+public:
+
+  /**
+   * Default configuration addresses.
+   */
+  static const uint32 ADDRESS = 0x00001000;
+
+  /**
+   * Number of DMA channels.
+   */
+  static const int32 CHANNELS_NUMBER = 6;
+
+  /**
+   * Constructor.
+   */
+  DmaRegister() :
+    dmactrl       (), // PROTECTED
+    debugctrl     (), // PROTECTED
+    revision      (), // PROTECTED
+    priorityctrl1 (), // PROTECTED
+    prioritystat  (){ // PROTECTED
+  }
+
+  /**
+   * Destructor.
+   */
+ ~DmaRegister(){}
+
+  /**
+   * Operator new.
+   *
+   * @param size unused.
+   * @param ptr  address of memory.
+   * @return address of memory.
+   */
+  void* operator new(size_t, uint32 ptr)
+  {
+    return reinterpret_cast<void*>(ptr);
+  }
+
+  // EALLOW PROTECTED
+
+  /**
+   * DMA Control Register.
+   */
+  union Dmactrl
+  {
+    Dmactrl(){}
+    Dmactrl(uint16 v){val = v;}
+   ~Dmactrl(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16 hardreset      : 1;
+      uint16 prioritysreset : 1;
+      uint16                : 14;
+    } bit;
+  } dmactrl;
+
+  /**
+   * Debug Control Register.
+   */
+  union Debugctrl
+  {
+    Debugctrl(){}
+    Debugctrl(uint16 v){val = v;}
+   ~Debugctrl(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16      : 15;
+      uint16 free : 1;
+    } bit;
+  } debugctrl;
+
+  /**
+   * Peripheral Revision Register.
+   */
+  union Revision
+  {
+    Revision(){}
+    Revision(uint16 v){val = v;}
+   ~Revision(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16 rev  : 8;
+      uint16 type : 8;
+    } bit;
+  } revision;
+
+private:
+
+  uint16 space0_[1];
+
+public:
+
+  /**
+   * Priority Control Register 1.
+   */
+  union Priorityctrl1
+  {
+    Priorityctrl1(){}
+    Priorityctrl1(uint16 v){val = v;}
+   ~Priorityctrl1(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16 ch1pri : 1;
+      uint16        : 15;
+    } bit;
+  } priorityctrl1;
+
+private:
+
+  uint16 space1_[1];
+
+public:
+
+  /**
+   * Priority Status Register.
+   */
+  union Prioritystat
+  {
+    Prioritystat(){}
+    Prioritystat(uint16 v){val = v;}
+   ~Prioritystat(){}
+
+    uint16 val;
+    struct Val
+    {
+      uint16 activests        : 3;
+      uint16                  : 1;
+      uint16 activests_shadow : 3;
+      uint16                  : 9;
+    } bit;
+  } prioritystat;
+
+private:
+
+  uint16 space2_[25];
+
+public:
+
+  /**
+   * DMA channel registers.
+   */
+  struct Channel
+  {
+    /**
+     * Constructor.
+     */
+    Channel(){}
+
+    /**
+     * Destructor.
+     */
+   ~Channel(){}
+
+    /**
+     * Mode Register.
+     */
+    union Mode
+    {
+      Mode(){}
+      Mode(uint16 v){val = v;}
+     ~Mode(){}
+
+      uint16 val;
+      struct Val
+      {
+        uint16 perintsel  : 5;
+        uint16            : 2;
+        uint16 ovrinte    : 1;
+        uint16 perinte    : 1;
+        uint16 chintmode  : 1;
+        uint16 oneshot    : 1;
+        uint16 continuous : 1;
+        uint16 synce      : 1;
+        uint16 syncsel    : 1;
+        uint16 datasize   : 1;
+        uint16 chinte     : 1;
+      } bit;
+    } mode;
+
+    /**
+     * Control Register.
+     */
+    union Control
+    {
+      Control(){}
+      Control(uint16 v){val = v;}
+     ~Control(){}
+
+      uint16 val;
+      struct Val
+      {
+        uint16 run         : 1;
+        uint16 halt        : 1;
+        uint16 softreset   : 1;
+        uint16 perintfrc   : 1;
+        uint16 perintclr   : 1;
+        uint16 syncfrc     : 1;
+        uint16 syncclr     : 1;
+        uint16 errclr      : 1;
+        uint16 perintflg   : 1;
+        uint16 syncflg     : 1;
+        uint16 syncerr     : 1;
+        uint16 transfersts : 1;
+        uint16 burststs    : 1;
+        uint16 runsts      : 1;
+        uint16 ovrflg      : 1;
+        uint16             : 1;
+      } bit;
+    } control;
+
+    /**
+     * Burst Size Register.
+     */
+    uint16 burstSize;
+
+    /**
+     * Burst Count Register.
+     */
+    uint16 burstCount;
+
+    /**
+     * Source Burst Step Register.
+     */
+    int16 srcBurstStep;
+
+    /**
+     * Destination Burst Step Register.
+     */
+    int16 dstBurstStep;
+
+    /**
+     * Transfer Size Register.
+     */
+    uint16 transferSize;
+
+    /**
+     * Transfer Count Register.
+     */
+    uint16 transferCount;
+
+    /**
+     * Source Transfer Step Register.
+     */
+    int16 srcTransferStep;
+
+    /**
+     * Destination Transfer Step Register.
+     */
+    int16 dstTransferStep;
+
+    /**
+     * Source Wrap Size Register.
+     */
+    uint16 srcWrapSize;
+
+    /**
+     * Source Wrap Count Register.
+     */
+    uint16 srcWrapCount;
+
+    /**
+     * Source Wrap Step Register.
+     */
+    int16 srcWrapStep;
+
+    /**
+     * Destination Wrap Size Register.
+     */
+    uint16 dstWrapSize;
+
+    /**
+     * Destination Wrap Count Register.
+     */
+    uint16 dstWrapCount;
+
+    /**
+     * Destination Wrap Step Register.
+     */
+    int16 dstWrapStep;
+
+    /**
+     * Source Begin Address Shadow Register.
+     */
+    uint32 srcBegAddrShadow;
+
+    /**
+     * Source Address Shadow Register.
+     */
+    uint32 srcAddrShadow;
+
+    /**
+     * Source Begin Address Active Register.
+     */
+    uint32 srcBegAddrActive;
+
+    /**
+     * Source Address Active Register.
+     */
+    uint32 srcAddrActive;
+
+    /**
+     * Destination Begin Address Shadow Register.
+     */
+    uint32 dstBegAddrShadow;
+
+    /**
+     * Destination Address Shadow Register.
+     */
+    uint32 dstAddrShadow;
+
+    /**
+     * Destination Begin Address Active Register.
+     */
+    uint32 dstBegAddrActive;
+
+    /**
+     * Destination Address Active Register.
+     */
+    uint32 dstAddrActive;
+
+  } ch[CHANNELS_NUMBER];
+
+};
+#endif // DRIVER_DMA_REGISTER_HPP_
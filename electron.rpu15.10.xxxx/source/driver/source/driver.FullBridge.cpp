@@ -4,10 +4,29 @@
  * @author    Sergey Baigudin, sergey@baigudin.software
  */
 #include "driver.FullBridge.hpp"
+#include "driver.FullBridgeController.hpp"
 #include "driver.System.hpp"
 #include "driver.SystemRegister.hpp"
 #include "driver.GpioRegister.hpp"
 
+/**
+ * Returns the phase-shifted full-bridge resource interface.
+ *
+ * @param clock    the PWM internal clock based on the CPU clock in Hz.
+ * @param number   a number of the PWM module of the first leg.
+ * @param deadBand the rising and falling edges delay of the legs in ns.
+ * @param hiRes    the phase is controlled by the micro edge positioner.
+ * @return the full-bridge interface, or null if error has been occurred.
+ */
+::FullBridge* FullBridge::create(int32 clock, int32 number, float32 deadBand, bool hiRes)
+{
+  FullBridgeController* res = new FullBridgeController(clock, number, deadBand, hiRes);
+  if(res == NULL) return NULL;
+  if(res->isConstructed()) return res;
+  delete res;
+  return NULL;
+}
+
 /**
  * Initializes the driver.
  *
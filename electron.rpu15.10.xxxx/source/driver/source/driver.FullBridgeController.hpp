@@ -0,0 +1,481 @@
+/**
+ * Phase-shifted full-bridge controller.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_FULL_BRIDGE_CONTROLLER_HPP_
+#define DRIVER_FULL_BRIDGE_CONTROLLER_HPP_
+
+#include "driver.Object.hpp"
+#include "driver.FullBridge.hpp"
+#include "driver.Interrupt.hpp"
+#include "driver.InterruptTask.hpp"
+#include "driver.GpioRegister.hpp"
+
+class FullBridgeController : public ::Object, public ::FullBridge, public ::InterruptTask
+{
+  typedef ::Object  Parent;
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param clock    the PWM internal clock based on the CPU clock in Hz.
+   * @param number   a number of the PWM module of the first leg.
+   * @param deadBand the rising and falling edges delay of the legs in ns.
+   * @param hiRes    the phase is controlled by the micro edge positioner.
+   */
+  FullBridgeController(int32 clock, int32 number, float32 deadBand, bool hiRes) : Parent(),
+    group_    (NULL),
+    phase_    (0),
+    maxPhase_ (0),
+    maxSteps_ (0),
+    regGpio_  (NULL),
+    counter_  (),
+    holdoff_  (0),
+    isHoldoff_(false),
+    fault_    (FAULT_NONE){
+    leg_[0] = NULL;
+    leg_[1] = NULL;
+    zone_[0] = 0;
+    zone_[1] = 0;
+    setConstruct( construct(clock, number, deadBand, hiRes) );
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~FullBridgeController()
+  {
+    if(isConstructed()) resetMonitor();
+    stop();
+    delete group_;
+    delete leg_[1];
+    delete leg_[0];
+  }
+
+  /**
+   * Starts the phase-shifted full-bridge.
+   *
+   * @param frequency a frequency integer part of the legs in Hz.
+   * @param fraction  a frequency fractional part of the legs in 1/65536 Hz.
+   * @return true if the bridge has been started successfully.
+   */
+  virtual bool start(int32 frequency, uint16 fraction=0)
+  {
+    if(!isConstructed() || frequency <= 0) return false;
+    ::Pwm::TaskData<CHANNELS_NUMBER> data = {frequency, 50.0f, 50.0f, fraction};
+    ::Pwm::Task<CHANNELS_NUMBER> task = data;
+    for(int32 i=0; i<LEGS_NUMBER; i++)
+    {
+      if(!group_->setTask(i, task)) return false;
+    }
+    // The phase is limited to the period register of the real frequency
+    ::Pwm::Image image;
+    if(!leg_[0]->compile(task, image)) return false;
+    maxPhase_ = getMaxPhase(image);
+    if(phase_ > maxPhase_) phase_ = maxPhase_;
+    if(!group_->setPhase(1, phase_)) return false;
+    // The first leg forces the synchronization, which loads the phase of the second leg
+    if(!group_->commit(true)) return false;
+    maxSteps_ = static_cast<int32>( static_cast<float32>(maxPhase_) / leg_[1]->getPhaseResolution() );
+    return true;
+  }
+
+  /**
+   * Stops the full-bridge.
+   */
+  virtual void stop()
+  {
+    if(!isConstructed()) return;
+    leg_[0]->stop();
+    leg_[1]->stop();
+  }
+
+  /**
+   * Sets the phase shift time of the legs.
+   *
+   * @param time the phase shift time in ns.
+   * @return true if the phase has been set successfully.
+   */
+  virtual bool setPhase(int32 time)
+  {
+    if(!isConstructed() || time < 0) return false;
+    if(maxPhase_ != 0 && time > maxPhase_) time = maxPhase_;
+    leg_[1]->setPhase(time);
+    phase_ = time;
+    return true;
+  }
+
+  /**
+   * Sets the phase shift of the legs in steps of the phase resolution.
+   *
+   * @param steps the phase shift in steps.
+   * @return true if the phase has been set successfully.
+   */
+  virtual bool setPhaseSteps(int32 steps)
+  {
+    if(!isConstructed() || steps < 0) return false;
+    if(maxSteps_ != 0 && steps > maxSteps_) steps = maxSteps_;
+    leg_[1]->setPhaseSteps(steps);
+    phase_ = leg_[1]->getPhase();
+    return true;
+  }
+
+  /**
+   * Returns the achieved resolution of the phase shift.
+   *
+   * @return the phase resolution in ns, or ERROR if error has been occurred.
+   */
+  virtual float32 getPhaseResolution() const
+  {
+    if(!isConstructed()) return ::Pwm::ERROR;
+    return leg_[1]->getPhaseResolution();
+  }
+
+  /**
+   * Returns a PWM module of a leg.
+   *
+   * @param leg a leg index from 0 to LEGS_NUMBER - 1.
+   * @return reference to the PWM module interface.
+   */
+  virtual ::Pwm& getLeg(int32 leg)
+  {
+    return leg == 0 ? *leg_[0] : *leg_[1];
+  }
+
+  /**
+   * Sets monitoring of the DRV8432 fault outputs.
+   *
+   * @param fault   a trip zone number from 1 to 6 of the FAULT output, or zero if it is not monitored.
+   * @param otw     a trip zone number from 1 to 6 of the OTW output, or zero if it is not monitored.
+   * @param holdoff min number of PWM periods between the fault outputs release and a restart.
+   * @return true if the monitoring has been set successfully.
+   */
+  virtual bool setMonitor(int32 fault, int32 otw, int32 holdoff)
+  {
+    if(!isConstructed() || holdoff < 0) return false;
+    if(fault < 0 || TRIP_ZONES_NUMBER < fault) return false;
+    if(otw < 0 || TRIP_ZONES_NUMBER < otw) return false;
+    if(fault != 0 && fault == otw) return false;
+    resetMonitor();
+    zone_[0] = fault;
+    zone_[1] = otw;
+    holdoff_ = holdoff;
+    for(int32 i=0; i<LEGS_NUMBER; i++)
+    {
+      ::Pwm::TripZone& tz = leg_[i]->getTripZone();
+      for(int32 j=0; j<CHANNELS_NUMBER; j++)
+      {
+        if(!tz.setAction(j, ::Pwm::TRIP_LOW)) return false;
+      }
+      for(int32 j=0; j<FAULT_PINS_NUMBER; j++)
+      {
+        if(zone_[j] != 0 && !tz.setZone(zone_[j], ::Pwm::TRIP_OSHT)) return false;
+      }
+    }
+    // The first leg trip interrupt latches the causes
+    return leg_[0]->getTripZone().setHandler(*this);
+  }
+
+  /**
+   * Returns the latched fault causes.
+   *
+   * @return the fault causes mask, or ERROR if error has been occurred.
+   */
+  virtual int32 getFault() const
+  {
+    return isConstructed() ? fault_ : ::Pwm::ERROR;
+  }
+
+  /**
+   * Tests if the legs are tripped by a fault.
+   *
+   * @return true if the legs are tripped.
+   */
+  virtual bool isFaulted() const
+  {
+    if(!isConstructed()) return false;
+    for(int32 i=0; i<LEGS_NUMBER; i++)
+    {
+      if(leg_[i]->getTripZone().isTripped(::Pwm::TRIP_OSHT)) return true;
+    }
+    return false;
+  }
+
+  /**
+   * Restarts the legs after a fault.
+   *
+   * @return true if the legs are not tripped or they have been restarted.
+   */
+  virtual bool restart()
+  {
+    if(!isConstructed()) return false;
+    if(!isFaulted()) return true;
+    // The hold-off time is restarted while a fault output is active
+    if(getActive() != FAULT_NONE)
+    {
+      stopHoldoff();
+      return false;
+    }
+    if(!isHoldoff_)
+    {
+      counter_.count = 0;
+      if(!leg_[0]->getTrigger().setInterrupt(counter_, ::Pwm::CTR_ZERO, Counter::PERIOD)) return false;
+      isHoldoff_ = true;
+      return false;
+    }
+    if(counter_.count < holdoff_) return false;
+    stopHoldoff();
+    // Release the outputs of both legs together
+    bool is = Interrupt::globalDisable();
+    for(int32 i=0; i<LEGS_NUMBER; i++) leg_[i]->getTripZone().clear(::Pwm::TRIP_OSHT);
+    fault_ = FAULT_NONE;
+    Interrupt::globalEnable(is);
+    return true;
+  }
+
+  /**
+   * Latches the fault causes on a trip of the first leg.
+   */
+  virtual void handler()
+  {
+    int32 cause = getActive();
+    fault_ |= cause != FAULT_NONE ? cause : static_cast<int32>(FAULT_UNKNOWN);
+  }
+
+  /**
+   * Tests if this object has been constructed.
+   *
+   * @return true if object has been constructed successfully.
+   */
+  virtual bool isConstructed() const
+  {
+    return this->Parent::isConstructed();
+  }
+
+private:
+
+  /**
+   * Number of channels of the legs.
+   */
+  static const int32 CHANNELS_NUMBER = 2;
+
+  /**
+   * Number of the DRV8432 fault outputs.
+   */
+  static const int32 FAULT_PINS_NUMBER = 2;
+
+  /**
+   * Number of the trip zones.
+   */
+  static const int32 TRIP_ZONES_NUMBER = 6;
+
+  /**
+   * The PWM periods counter of the hold-off time.
+   */
+  struct Counter : public ::InterruptTask
+  {
+    /**
+     * Number of PWM periods between the interrupts.
+     */
+    static const int32 PERIOD = 3;
+
+    /**
+     * Constructor.
+     */
+    Counter() : ::InterruptTask(),
+      count (0){
+    }
+
+    /**
+     * Destructor.
+     */
+    virtual ~Counter(){}
+
+    /**
+     * Counts the PWM periods.
+     */
+    virtual void handler()
+    {
+      count += PERIOD;
+    }
+
+    /**
+     * Number of elapsed PWM periods.
+     */
+    volatile int32 count;
+
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param clock    the PWM internal clock based on the CPU clock in Hz.
+   * @param number   a number of the PWM module of the first leg.
+   * @param deadBand the rising and falling edges delay of the legs in ns.
+   * @param hiRes    the phase is controlled by the micro edge positioner.
+   * @return boolean result.
+   */
+  bool construct(int32 clock, int32 number, float32 deadBand, bool hiRes)
+  {
+    if(!Parent::isConstructed()) return false;
+    regGpio_ = new (GpioRegister::ADDRESS) GpioRegister();
+    if(deadBand < 0.0f) return false;
+    for(int32 i=0; i<LEGS_NUMBER; i++)
+    {
+      leg_[i] = ::Pwm::create(clock, number + i, ::Pwm::UP);
+      if(leg_[i] == NULL) return false;
+      // Set the channel B is the inverted channel A with the dead-band delays
+      ::Pwm::DeadBand& db = leg_[i]->getDeadBand();
+      db.setRisingDelay(deadBand);
+      db.setFallingDelay(deadBand);
+      db.getInput(0).disable();
+      db.getPolarity(0).disable();
+      db.getOutput(0).enable();
+      db.getInput(1).disable();
+      db.getPolarity(1).enable();
+      db.getOutput(1).enable();
+    }
+    if(hiRes && !leg_[1]->enableHighResolution(::Pwm::HR_PHASE)) return false;
+    // The first leg synchronizes the second leg on each period
+    leg_[0]->setSynchronization(::Pwm::PERIOD);
+    leg_[1]->getPhaseKey().enable();
+    leg_[1]->setSynchronization(::Pwm::DISABLE);
+    group_ = ::Pwm::Group::create(leg_, LEGS_NUMBER);
+    if(group_ == NULL) return false;
+    return true;
+  }
+
+  /**
+   * Resets monitoring of the fault outputs.
+   */
+  void resetMonitor()
+  {
+    stopHoldoff();
+    leg_[0]->getTripZone().resetHandler();
+    for(int32 i=0; i<LEGS_NUMBER; i++)
+    {
+      for(int32 j=0; j<FAULT_PINS_NUMBER; j++)
+      {
+        if(zone_[j] != 0) leg_[i]->getTripZone().resetZone(zone_[j]);
+      }
+    }
+    zone_[0] = 0;
+    zone_[1] = 0;
+  }
+
+  /**
+   * Stops counting the hold-off time.
+   */
+  void stopHoldoff()
+  {
+    if(!isHoldoff_) return;
+    leg_[0]->getTrigger().resetInterrupt();
+    isHoldoff_ = false;
+  }
+
+  /**
+   * Returns the active fault outputs.
+   *
+   * @return the fault causes mask of the active-low outputs.
+   */
+  int32 getActive() const
+  {
+    int32 cause = FAULT_NONE;
+    uint32 dat = regGpio_->gpadat.val;
+    // The TZ1 to TZ6 zones are the GPIO12 to GPIO17 pins
+    if(zone_[0] != 0 && (dat >> (zone_[0] + 11) & 0x1) == 0) cause |= FAULT_BRIDGE;
+    if(zone_[1] != 0 && (dat >> (zone_[1] + 11) & 0x1) == 0) cause |= FAULT_TEMPERATURE;
+    return cause;
+  }
+
+  /**
+   * Returns max phase shift time of the legs.
+   *
+   * The phase loaded to the time-base counter of the up-count mode has to be 
+   * no more than the period register. Otherwise, the counter misses the period
+   * event and the leg stops switching until the counter wraps around.
+   *
+   * @param image a register image of the legs task.
+   * @return the phase time in ns.
+   */
+  static int32 getMaxPhase(const ::Pwm::Image& image)
+  {
+    // The time of the period register value is rounded down
+    return static_cast<int32>( static_cast<uint64>(image.tbprd) * 1000000000 / static_cast<uint32>(image.clock) );
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  FullBridgeController(const FullBridgeController& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  FullBridgeController& operator =(const FullBridgeController& obj);
+
+  /**
+   * The PWM modules of the legs.
+   */
+  ::Pwm* leg_[LEGS_NUMBER];
+
+  /**
+   * The group of the legs.
+   */
+  ::Pwm::Group* group_;
+
+  /**
+   * The phase shift time in ns.
+   */
+  int32 phase_;
+
+  /**
+   * Max phase shift time in ns.
+   */
+  int32 maxPhase_;
+
+  /**
+   * Max phase shift in steps.
+   */
+  int32 maxSteps_;
+
+  /**
+   * GPIO Registers.
+   */
+  GpioRegister* regGpio_;
+
+  /**
+   * The trip zones of the FAULT and OTW outputs.
+   */
+  int32 zone_[FAULT_PINS_NUMBER];
+
+  /**
+   * The hold-off time counter.
+   */
+  Counter counter_;
+
+  /**
+   * Number of PWM periods of the hold-off time.
+   */
+  int32 holdoff_;
+
+  /**
+   * The hold-off time is being counted.
+   */
+  bool isHoldoff_;
+
+  /**
+   * The latched fault causes which are changed in the interrupt service routine.
+   */
+  volatile int32 fault_;
+
+};
+#endif // DRIVER_FULL_BRIDGE_CONTROLLER_HPP_
@@ -7,6 +7,11 @@
 #include "driver.PwmControllerUpDown.hpp"
 #include "driver.PwmControllerUp.hpp"
 #include "driver.PwmControllerDown.hpp"
+#include "driver.PwmGroupController.hpp"
+#include "driver.PwmSineController.hpp"
+#include "driver.PwmVectorController.hpp"
+#include "driver.PwmRampController.hpp"
+#include "driver.PwmDitherController.hpp"
 
 /**
  * Returns the driver resource interface.
@@ -33,6 +38,109 @@
   return NULL;    
 }
 
+/**
+ * Returns a group of PWM modules.
+ *
+ * @param members an array of PWM modules created by the driver.
+ * @param number  a number of the PWM modules in the array.
+ * @return the group interface, or null if error has been occurred.
+ */
+::Pwm::Group* Pwm::Group::create(::Pwm** members, int32 number)
+{
+  PwmGroupController* res = new PwmGroupController(members, number);
+  if(res == NULL) return NULL;
+  if(res->isConstructed()) return res;
+  delete res;
+  return NULL;
+}
+
+/**
+ * Returns a sinusoidal PWM generator.
+ *
+ * @param pwm      a PWM module created by the driver.
+ * @param table    a sine table of one period in Q15 format.
+ * @param length   a number of the table elements.
+ * @param capacity max number of PWM periods in one output wave period.
+ * @param issue    the SOC signal which triggers the DMA channel.
+ * @return the generator interface, or null if error has been occurred.
+ */
+::Pwm::Sine* Pwm::Sine::create(::Pwm& pwm, const int16* table, int32 length, int32 capacity, TriggerIssue issue)
+{
+  PwmSineController* res = new PwmSineController(pwm, table, length, capacity, issue);
+  if(res == NULL) return NULL;
+  if(res->isConstructed()) return res;
+  delete res;
+  return NULL;
+}
+
+/**
+ * Returns a space vector modulator.
+ *
+ * @param phases an array of three PWM modules for the phases A, B and C.
+ * @return the modulator interface, or null if error has been occurred.
+ */
+::Pwm::SpaceVector* Pwm::SpaceVector::create(::Pwm** phases)
+{
+  PwmVectorController* res = new PwmVectorController(phases);
+  if(res == NULL) return NULL;
+  if(res->isConstructed()) return res;
+  delete res;
+  return NULL;
+}
+
+/**
+ * Returns a ramp generator.
+ *
+ * @param members an array of PWM modules created by the driver.
+ * @param number  a number of the PWM modules in the array.
+ * @return the generator interface, or null if error has been occurred.
+ */
+::Pwm::Ramp* Pwm::Ramp::create(::Pwm** members, int32 number)
+{
+  PwmRampController* res = new PwmRampController(members, number);
+  if(res == NULL) return NULL;
+  if(res->isConstructed()) return res;
+  delete res;
+  return NULL;
+}
+
+/**
+ * Returns a spread-spectrum frequency dither.
+ *
+ * @param pwm      a PWM module created by the driver.
+ * @param capacity max number of PWM periods in the sequence.
+ * @return the dither interface, or null if error has been occurred.
+ */
+::Pwm::Dither* Pwm::Dither::create(::Pwm& pwm, int32 capacity)
+{
+  PwmDitherController* res = new PwmDitherController(pwm, capacity);
+  if(res == NULL) return NULL;
+  if(res->isConstructed()) return res;
+  delete res;
+  return NULL;
+}
+
+/**
+ * Executes one step of the high resolution calibration.
+ *
+ * @return true if a calibration step has been executed.
+ */
+bool Pwm::calibrate()
+{
+  return PwmController::calibrate();
+}
+
+/**
+ * Returns the high resolution calibration report.
+ *
+ * @param report a report to be filled.
+ * @return true if the report has been filled successfully.
+ */
+bool Pwm::getCalibration(Calibration& report)
+{
+  return PwmController::getCalibration(report);
+}
+
 /**
  * Initializes the driver.
  *
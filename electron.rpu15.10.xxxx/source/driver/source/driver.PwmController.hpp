@@ -12,24 +12,63 @@
 #include "driver.System.hpp"
 #include "driver.SystemRegister.hpp"
 #include "driver.GpioRegister.hpp"
+#include "driver.DmaRegister.hpp"
 #include "driver.Mutex.hpp"
 #include "driver.Interrupt.hpp"
 #include "driver.PwmHighResolution.hpp"
 
+class PwmGroupController;
+class PwmSineController;
+class PwmVectorController;
+class PwmRampController;
+class PwmDitherController;
+
 class PwmController : public ::Object, 
                       public ::Pwm, 
                       public ::Pwm::DeadBand, 
                       public ::Pwm::Chopper,
-                      public ::Pwm::EventTrigger
+                      public ::Pwm::EventTrigger,
+                      public ::Pwm::TripZone,
+                      public ::Pwm::ActionQualifier,
+                      public ::InterruptTask
 {
   typedef ::Object                    Parent;
   typedef ::PwmRegister::Tbctl::Val   Tbctl;
   typedef ::PwmRegister::Cmpctl::Val  Cmpctl;
   typedef ::PwmRegister::Aqctl::Val   Aqctl;
   typedef ::PwmRegister::Dbctl::Val   Dbctl;
+  typedef ::PwmRegister::Tzflg::Val   Tzflg;
+  typedef ::PwmRegister::Aqsfrc::Val  Aqsfrc;
   
   using   ::Pwm::getDuty;
   using   ::Pwm::Chopper::getDuty;  
+  using   ::Pwm::setDuty;
+  using   ::Pwm::Chopper::setDuty;
+  
+  /**
+   * The group controller writes staged values of its members directly.
+   */
+  friend class ::PwmGroupController;
+  
+  /**
+   * The sine controller reads the duty scaling of its PWM module.
+   */
+  friend class ::PwmSineController;
+
+  /**
+   * The space vector modulator writes the compare values of its PWM modules.
+   */
+  friend class ::PwmVectorController;
+
+  /**
+   * The ramp generator compiles and writes the tasks of its PWM modules.
+   */
+  friend class ::PwmRampController;
+
+  /**
+   * The dither writes the period and compare values of its PWM module.
+   */
+  friend class ::PwmDitherController;
   
 public:
 
@@ -42,14 +81,25 @@ public:
   PwmController(int32 clock, int32 index) : Parent(),
     #ifdef    DRIVER_HRPWM
     isHiRes_  (false),
+    isHiResPhase_ (false),
     #endif // DRIVER_HRPWM
     regPwm_   (NULL),
     mutex_    (),
     task_     (),
     index_    (index),
     tbclk_    (0),
+    isAutoClock_ (false),
     deadBand_ (),
-    chopper_  (){
+    chopper_  (),
+    compare_  (),
+    time_     (),
+    delay_    (0),
+    tripInt_  (NULL),
+    tripTask_ (NULL),
+    eventInt_ (NULL),
+    eventTask_(NULL),
+    prescaler_(),
+    burst_    (){
     setConstruct( construct(clock) );
   }
 
@@ -59,12 +109,17 @@ public:
   virtual ~PwmController()
   {
     if(!isConstructed()) return;
+    resetHandler();
+    resetEvent(Pwm::ADC_SOCA);
+    resetEvent(Pwm::ADC_SOCB);
+    resetInterrupt();
     if(!mutex_.drv.lock()) return;
     #ifdef DRIVER_HRPWM
     MEP_ScaleFactor[index_+1] = 0;
     #endif // DRIVER_HRPWM
     clockOn(false);
     lock_[index_] = false;
+    controller_[index_] = NULL;
     regPwm_ = NULL;
     index_ = ERROR;
     mutex_.drv.unlock();
@@ -85,6 +140,253 @@ public:
     return mutex_.res.unlock( true );
   }
   
+  /**
+   * Starts generating the tasked wave of the PWM module.
+   *
+   * @return true if the task has been started successfully.
+   */
+  virtual bool start()
+  {
+    if(!isConstructed()) return false;
+    if(!mutex_.res.lock()) return false;
+    Image image;
+    if(!compileImage(task_, image)) return mutex_.res.unlock( false );
+    return mutex_.res.unlock( applyImage(image) );
+  }
+
+  /**
+   * Compiles a task into a register image.
+   *
+   * @param task  a task for compiling.
+   * @param image a register image to be filled.
+   * @return true if the task has been compiled successfully.
+   */
+  virtual bool compile(const TaskInterface& task, Image& image) const
+  {
+    if(!isConstructed()) return false;
+    if(!mutex_.res.lock()) return false;
+    return mutex_.res.unlock( compileImage(task, image) );
+  }
+
+  /**
+   * Starts generating a wave of compiled register image.
+   *
+   * @param image a register image compiled by the PWM module.
+   * @return true if the image has been applied successfully.
+   */
+  virtual bool apply(const Image& image)
+  {
+    if(!isConstructed()) return false;
+    if(!mutex_.res.lock()) return false;
+    return mutex_.res.unlock( applyImage(image) );
+  }
+  
+  /**
+   * Takes a snapshot of the module configuration.
+   *
+   * @param profile a profile to be filled.
+   * @return true if the snapshot has been taken successfully.
+   */
+  virtual bool snapshot(Profile& profile) const
+  {
+    if(!isConstructed()) return false;
+    if(!mutex_.res.lock()) return false;
+    if(isPrescaled() || isBursting()) return mutex_.res.unlock(false);
+    bool is = Interrupt::globalDisable();
+    readImage(profile.image);
+    profile.tbctl = regPwm_->tbctl.val & PROFILE_TBCTL_MASK;
+    profile.tbphs = regPwm_->tbphs.val;
+    profile.tbphshr = regPwm_->tbphshr.val;
+    profile.aqsfrc = regPwm_->aqsfrc.val;
+    profile.aqcsfrc = regPwm_->aqcsfrc.val;
+    profile.dbctl = regPwm_->dbctl.val;
+    profile.dbred = regPwm_->dbred.val;
+    profile.dbfed = regPwm_->dbfed.val;
+    profile.pcctl = regPwm_->pcctl.val;
+    profile.etsel = regPwm_->etsel.val & PROFILE_SOC_MASK;
+    profile.etps = regPwm_->etps.val & PROFILE_SOC_MASK;
+    profile.tzsel = regPwm_->tzsel.val;
+    profile.tzctl = regPwm_->tzctl.val;
+    Interrupt::globalEnable(is);
+    profile.hiRes = getHighResolutionMode();
+    profile.rising = deadBand_.rising;
+    profile.falling = deadBand_.falling;
+    profile.chopperFrequency = chopper_.freq;
+    profile.chopperDuty = chopper_.duty;
+    profile.chopperPulse = chopper_.pulse;
+    return mutex_.res.unlock(true);
+  }
+
+  /**
+   * Restores the module configuration from a profile.
+   *
+   * @param profile a profile taken by the snapshot method.
+   * @return true if the profile has been restored successfully.
+   */
+  virtual bool restore(const Profile& profile)
+  {
+    if(!isConstructed()) return false;
+    if(!mutex_.res.lock()) return false;
+    if(isPrescaled() || isBursting()) return mutex_.res.unlock(false);
+    if(profile.hiRes != getHighResolutionMode()) return mutex_.res.unlock(false);
+    if(!isImage(profile.image)) return mutex_.res.unlock(false);
+    bool is = Interrupt::globalDisable();
+    if(!waitWindow())
+    {
+      Interrupt::globalEnable(is);
+      return mutex_.res.unlock(false);
+    }
+    writeImage(profile.image);
+    regPwm_->tbctl.val = (regPwm_->tbctl.val & ~PROFILE_TBCTL_MASK) | profile.tbctl;
+    regPwm_->tbphs.val = profile.tbphs;
+    regPwm_->tbphshr.val = profile.tbphshr;
+    regPwm_->aqsfrc.val = profile.aqsfrc;
+    regPwm_->aqcsfrc.val = profile.aqcsfrc;
+    regPwm_->dbctl.val = profile.dbctl;
+    regPwm_->dbred.val = profile.dbred;
+    regPwm_->dbfed.val = profile.dbfed;
+    regPwm_->pcctl.val = profile.pcctl;
+    regPwm_->etsel.val = (regPwm_->etsel.val & ~PROFILE_SOC_MASK) | profile.etsel;
+    regPwm_->etps.val = (regPwm_->etps.val & ~PROFILE_SOC_MASK) | profile.etps;
+    System::eallow();
+    regPwm_->tzsel.val = profile.tzsel;
+    regPwm_->tzctl.val = profile.tzctl;
+    System::dallow();
+    Interrupt::globalEnable(is);
+    deadBand_.rising = profile.rising;
+    deadBand_.falling = profile.falling;
+    chopper_.freq = profile.chopperFrequency;
+    chopper_.duty = profile.chopperDuty;
+    chopper_.pulse = profile.chopperPulse;
+    return mutex_.res.unlock(true);
+  }
+  
+  /**
+   * Generates an exact number of pulses, after that the outputs are forced low.
+   *
+   * @param pulses a number of pulses from 1 to 65535.
+   * @return true if the burst has been started successfully.
+   */
+  virtual bool burst(int32 pulses)
+  {
+    if(!isConstructed()) return false;
+    if(pulses < 1 || BURST_PULSES_MAX < pulses) return false;
+    if(!mutex_.res.lock()) return false;
+    if(isBursting()) return mutex_.res.unlock(false);
+    int32 event = getBoundaryEvent();
+    uint16 bit = getEnableEvenBits(event);
+    if( bit == 0xffff ) return mutex_.res.unlock(false);
+    // The interrupt has to be generated on each boundary event
+    if(regPwm_->etsel.bit.inten == 1 && (regPwm_->etsel.bit.intsel != bit || regPwm_->etps.bit.intprd != 1)) return mutex_.res.unlock(false);
+    if(!openInterrupt(bit, 1)) return mutex_.res.unlock(false);
+    regPwm_->aqcsfrc.val = BURST_FORCE;
+    bool is = Interrupt::globalDisable();
+    if(!waitWindow())
+    {
+      regPwm_->aqcsfrc.val = 0x0000;
+      Interrupt::globalEnable(is);
+      // The interrupt is kept for the user handler or the software prescaler
+      if(eventTask_ == NULL && !isPrescaled()) closeInterrupt();
+      return mutex_.res.unlock(false);
+    }
+    // Clear an event which has been occurred before the force is released
+    regPwm_->etclr.val = 0x0001;
+    regPwm_->aqsfrc.bit.rldcsf = event == Pwm::CTR_ZERO ? Aqsfrc::LOAD_CTR_EQ_ZERO : Aqsfrc::LOAD_CTR_EQ_PRD;
+    regPwm_->aqcsfrc.val = 0x0000;
+    burst_.count = 0;
+    burst_.pulses = pulses;
+    Interrupt::globalEnable(is);
+    return mutex_.res.unlock(true);
+  }
+  
+  /**
+   * Tests if a burst is being generated.
+   *
+   * @return true if the last pulse has not been completed.
+   */
+  virtual bool isBursting() const
+  {
+    return burst_.pulses != 0;
+  }
+  
+  /**
+   * Changes the frequency of the generating wave.
+   *
+   * @param frequency a new frequency in Hz.
+   * @param policy    a value which is kept for the new frequency.
+   * @return true if the new frequency has been loaded successfully.
+   */
+  virtual bool retune(int32 frequency, Retune policy=RETUNE_DUTY)
+  {
+    return retune(frequency, 0, policy);
+  }
+
+  /**
+   * Changes the frequency of the generating wave with a sub-hertz resolution.
+   *
+   * @param frequency a new frequency integer part in Hz.
+   * @param fraction  a new frequency fractional part in 1/65536 Hz.
+   * @param policy    a value which is kept for the new frequency.
+   * @return true if the new frequency has been loaded successfully.
+   */
+  virtual bool retune(int32 frequency, uint16 fraction, Retune policy=RETUNE_DUTY)
+  {
+    if(frequency <= 0) return false;
+    if(!isConstructed()) return false;
+    if(!mutex_.res.lock()) return false;
+    if(task_.getFrequency() == ERROR) return mutex_.res.unlock(false);
+    float32 prev = getHertz(task_.getFrequency(), task_.getFraction());
+    float32 next = getHertz(frequency, fraction);
+    TaskData<CHANNELS_NUMBER> data;
+    data.frequency = frequency;
+    data.fraction = fraction;
+    for(int32 i=0; i<CHANNELS_NUMBER; i++)
+    {
+      float32 duty = task_.getDuty(i);
+      // The pulse width is the duty divided by the frequency
+      if(policy == RETUNE_WIDTH) duty = duty * next / prev;
+      data.duty[i] = duty <= 100.0f ? duty : 100.0f;
+    }
+    ::Pwm::Task<CHANNELS_NUMBER> task = data;
+    Image image;
+    if(!compileImage(task, image)) return mutex_.res.unlock(false);
+    // The clock dividers have no shadow registers
+    if(image.clock != tbclk_) return mutex_.res.unlock(false);
+    // A stopped module loads shadow registers when it will be started
+    if(getLoadDistance() == ERROR) return mutex_.res.unlock( applyImage(image) );
+    bool is = Interrupt::globalDisable();
+    if(!waitWindow())
+    {
+      Interrupt::globalEnable(is);
+      return mutex_.res.unlock(false);
+    }
+    writeImage(image);
+    Interrupt::globalEnable(is);
+    return mutex_.res.unlock( waitLoad() );
+  }
+  
+  /**
+   * Returns the fractional part of the PWM signal frequency of currently assigned task.
+   *
+   * @param set flag allows getting the set or calculated value.
+   * @return the fractional part in 1/65536 Hz, or ERROR if error has been occurred.
+   */    
+  virtual int32 getSignalFraction(bool set) const
+  {
+    if(!isConstructed()) return ERROR;
+    if(set)
+    {
+      if(!mutex_.res.lock()) return ERROR;
+      int32 frac = task_.getFraction();
+      return mutex_.res.unlock(frac);
+    }
+    int32 prd = getSignalPeriod();
+    if(prd <= 0) return ERROR;
+    // The remainder is less than the period, thus the shifted value fits into 32 bits
+    uint32 rem = static_cast<uint32>(tbclk_ % prd);
+    return static_cast<int32>( static_cast<uint32>( (static_cast<uint64>(rem) << 16) / static_cast<uint32>(prd) ) );
+  }
+
   /**
    * Stops generating the wave of the PWM module.
    */
@@ -93,6 +395,7 @@ public:
     if(!isConstructed()) return;
     if(!mutex_.res.lock()) return;
     regPwm_->tbctl.bit.ctrmode = Tbctl::COUNT_FREEZE;
+    cancelBurst();
     mutex_.res.unlock();
   }   
   
@@ -126,15 +429,17 @@ public:
   {
     if(!isConstructed() || !isChannel(channel)) return ERROR;
     if(!mutex_.res.lock()) return ERROR;
-    float32 pwmclk = task_.getFrequency();
-    if(pwmclk == ERROR || pwmclk == 0.0f || tbclk_ == 0) return mutex_.res.unlock(ERROR);
-    float32 tbclk = static_cast<float32>(tbclk_);
-    float32 resol = tbclk / pwmclk;    
+    // Count of time-base clocks of the started period
+    int32 period = getCountPolicy() == Pwm::UPDOWN ? 2 * regPwm_->tbprd.val : regPwm_->tbprd.val + 1;
+    if(period <= 1) return mutex_.res.unlock(ERROR);
+    // The pulse width of up-down counting is changed by two clocks
+    float32 resol = static_cast<float32>( getCountPolicy() == Pwm::UPDOWN ? period / 2 : period );
     #ifdef DRIVER_HRPWM
-    if(isHiRes_ && channel == 0)
+    // The pulse width of the high resolution channel is changed by one MEP step
+    if(isHiResDuty() && channel == 0)
     {
       int32 mep = getMep();
-      if(mep != ERROR) resol = resol * static_cast<float32>(mep);
+      if(mep != ERROR) resol = static_cast<float32>(period) * static_cast<float32>(mep);
     }
     #endif // DRIVER_HRPWM        
     return mutex_.res.unlock( log2(resol) );    
@@ -143,11 +448,43 @@ public:
   /**
    * Enables the PWM channels in high resolution mode.
    *
+   * @param control a value controlled by the micro edge positioner.
    * @return true if high resolution mode is set successfully.
    */        
-  virtual bool enableHighResolution()
+  virtual bool enableHighResolution(HighResolution control)
   {
+    #ifdef DRIVER_HRPWM  
+    if(!isConstructed()) return false;
+    // TI highly recommends that TBCLK=SYSCLKOUT, which is always selected in the auto clock mode
+    if(tbclk_ != sysclk_ && !isAutoClock_) return false;
+    // TI says that min SYSCLKOUT must be 60 MHz
+    if(sysclk_ < 60000000) return false;
+    uint16 ctlmode;
+    switch(control)
+    {
+      case HR_DUTY  : ctlmode = 0x0; break;
+      case HR_PHASE : ctlmode = 0x1; break;
+      default       : return false;
+    }
+    // TI says that TBPHSHR is valid only in the up-count mode
+    if(control == HR_PHASE && getCountPolicy() != Pwm::UP) return false;
+    int32 edgmode = getEdgeMode();
+    if(edgmode == ERROR) return false;
+    if(!mutex_.res.lock()) return false;
+    System::eallow();    
+    // Set CMPAHR or TBPHSHR to controls the micro edge position
+    regPwm_->hrcnfg.bit.ctlmode = ctlmode;
+    // Control the edge position of the counting policy
+    regPwm_->hrcnfg.bit.edgmode = edgmode;
+    // Set CMPAHR is loaded when CTR equals to zero and match the CMPA selection
+    regPwm_->hrcnfg.bit.hrload = 0x0;
+    System::dallow();    
+    isHiRes_ = true;
+    isHiResPhase_ = control == HR_PHASE ? true : false;
+    return mutex_.res.unlock(true);
+    #else  // DRIVER_HRPWM
     return false;
+    #endif // DRIVER_HRPWM    
   }
   
   /**
@@ -160,7 +497,11 @@ public:
     if(!mutex_.res.lock()) return;
     regPwm_->tbphshr.bit.tbphsh = 0;
     regPwm_->cmpahr.bit.cmpahr = 0;
+    System::eallow();    
+    regPwm_->hrcnfg.bit.ctlmode = 0x0;
+    System::dallow();    
     isHiRes_ = false;
+    isHiResPhase_ = false;
     return mutex_.res.unlock();
     #else  // DRIVER_HRPWM
     return;
@@ -177,6 +518,31 @@ public:
     return isConstructed() ? tbclk_ : ERROR;
   }
   
+  /**
+   * Sets a compare value of the PWM module channel.
+   *
+   * @param channel available number of channel.
+   * @param value   a raw compare value in time-base clocks.
+   */
+  virtual void setCompare(int32 channel, uint16 value)
+  {
+    // The only check is one unsigned comparison, as the method is used in interrupt handlers
+    if(static_cast<uint32>(channel) >= CHANNELS_NUMBER) return;
+    regPwm_->cmp[channel].val = value;
+  }
+
+  /**
+   * Sets a duty of the PWM module channel.
+   *
+   * @param channel available number of channel.
+   * @param duty    a duty in Q15 format, where 0x8000 is 100%.
+   */
+  virtual void setDuty(int32 channel, uint16 duty)
+  {
+    if(static_cast<uint32>(channel) >= CHANNELS_NUMBER) return;
+    regPwm_->cmp[channel].val = getCompare(duty);
+  }
+  
   /**
    * Synchronizes the PWM module with a PWM module later in a synchronization chain.
    *
@@ -250,13 +616,21 @@ public:
     if(time < 0) return;  
     if(!isConstructed()) return;
     if(!mutex_.res.lock()) return;
-    #ifdef DRIVER_HRPWM    
-    // Lock up the phase shift for future backlog
-    if(isHiRes_) return mutex_.res.unlock();
-    #endif
-    int32 tbprd = 1000000000 / tbclk_;
-    int32 value = time / tbprd;
-    regPwm_->tbphs.val = value <= 0xffff ? value : 0xffff;
+    writePhase( getPhaseSteps(time) );
+    return mutex_.res.unlock();
+  }
+
+  /**
+   * Sets the PWM module phase shift in steps of the phase resolution.
+   *
+   * @param steps the PWN signals shift during synchronization in steps.
+   */      
+  virtual void setPhaseSteps(int32 steps)
+  {
+    if(steps < 0) return;  
+    if(!isConstructed()) return;
+    if(!mutex_.res.lock()) return;
+    writePhase(steps);
     return mutex_.res.unlock();
   }
 
@@ -269,9 +643,32 @@ public:
   {
     if(!isConstructed()) return ERROR;
     if(!mutex_.res.lock()) return ERROR;
-    int32 tbprd = 1000000000 / tbclk_;
-    int32 value = regPwm_->tbphs.val * tbprd;
-    return mutex_.res.unlock(value);
+    // The phase time in ns in Q16 format
+    uint64 value = static_cast<uint64>(regPwm_->tbphs.val) * time_.ns;
+    #ifdef DRIVER_HRPWM
+    if(isHiResPhase_)
+    {
+      // The high resolution is only for TBCLK=SYSCLKOUT, thus the product fits 32 bits
+      int32 mep = getMep();
+      if(mep != ERROR) value += static_cast<uint32>(regPwm_->tbphshr.bit.tbphsh) * time_.ns / static_cast<uint32>(mep);
+    }
+    #endif // DRIVER_HRPWM
+    return mutex_.res.unlock( static_cast<int32>( (value + 0x8000) >> 16 ) );
+  }
+
+  /**
+   * Returns the achieved resolution of the PWM module phase shift.
+   *
+   * @return the phase resolution in ns, or ERROR if error has been occurred.
+   */      
+  virtual float32 getPhaseResolution() const
+  {
+    if(!isConstructed()) return ERROR;
+    if(!mutex_.res.lock()) return ERROR;
+    int32 steps = getStepsPerClock();
+    if(steps == ERROR) return mutex_.res.unlock(ERROR);
+    float32 tbprd = static_cast<float32>(time_.ns) * (1.0f / 65536.0f);
+    return mutex_.res.unlock( tbprd / static_cast<float32>(steps) );
   }
   
   /**
@@ -348,10 +745,8 @@ public:
     if(time < 0) return;    
     if(!isConstructed()) return;
     if(!mutex_.res.lock()) return;    
-    float32 tbclk = static_cast<float32>(tbclk_);
-    float32 value = time / (1000000000.0f / tbclk) + 0.5f;    
     deadBand_.rising = time;    
-    regPwm_->dbred.bit.del = static_cast<uint16>(value);
+    regPwm_->dbred.bit.del = getDeadBandClocks(time);
     mutex_.res.unlock();    
   }
     
@@ -372,10 +767,7 @@ public:
     }
     else
     {
-      uint16 count = regPwm_->dbred.bit.del;
-      float32 tbclk = static_cast<float32>(tbclk_);      
-      float32 tbprd = 1000000000.0f / tbclk;
-      value = tbprd * static_cast<float32>(count);
+      value = static_cast<float32>( getTime(regPwm_->dbred.bit.del) );
     }
     return mutex_.res.unlock(value);
   }
@@ -390,10 +782,8 @@ public:
     if(time < 0) return;  
     if(!isConstructed()) return;  
     if(!mutex_.res.lock()) return;
-    float32 tbclk = static_cast<float32>(tbclk_);
-    float32 value = time / (1000000000.0f / tbclk) + 0.5f;    
     deadBand_.falling = time;    
-    regPwm_->dbfed.bit.del = static_cast<uint16>(value);
+    regPwm_->dbfed.bit.del = getDeadBandClocks(time);
     mutex_.res.unlock();
   } 
     
@@ -414,10 +804,7 @@ public:
     }
     else
     {
-      uint16 count = regPwm_->dbfed.bit.del;
-      float32 tbclk = static_cast<float32>(tbclk_);      
-      float32 tbprd = 1000000000.0f / tbclk;
-      value = tbprd * static_cast<float32>(count);
+      value = static_cast<float32>( getTime(regPwm_->dbfed.bit.del) );
     }
     return mutex_.res.unlock(value);
   }
@@ -684,7 +1071,8 @@ public:
     if(!isConstructed()) return;  
     if(!mutex_.res.lock()) return;
     uint16 bit;
-    uint32 mult = time / (8000 / (sysclk_ / 1000000));
+    // Number of one-shot pulse width units, which are truncated
+    uint32 mult = static_cast<uint32>( static_cast<uint64>(time) * pulse_.clocks >> 32 );
     if(mult == 0) bit = 0x0;
     else if(mult > 16) bit = 0xf;
     else bit = mult - 1;
@@ -710,9 +1098,8 @@ public:
     }
     else
     {
-      int32 mult = regPwm_->pcctl.bit.oshtwth + 1;
-      int32 wide = 8000 / (sysclk_ / 1000000);
-      pulse = mult * wide;
+      uint32 mult = regPwm_->pcctl.bit.oshtwth + 1;
+      pulse = static_cast<int32>( (mult * pulse_.ns + 0x8000) >> 16 );
     }
     return mutex_.res.unlock(pulse);  
   }
@@ -750,52 +1137,60 @@ public:
   /**
    * Sets triggering event.
    *
-   * @param issue an trigger issuing source.
-   * @param event an trigger received event.
+   * @param issue  an trigger issuing source.
+   * @param event  an trigger received event.
+   * @param period a number of events for generating a SOC trigger.
    * @return true if the event has been set successfully.
    */  
-  virtual bool setEvent(int32 issue, int32 event)
+  virtual bool setEvent(int32 issue, int32 event, int32 period=1)
   {
     if(!isConstructed()) return false;
+    if(period < 1) return false;
     if(!mutex_.res.lock()) return false;
     uint16 bit;
     bool res = false;
     switch(issue)
     {
       case Pwm::ADC_SOCA:
+      case Pwm::ADC_SOCB:
       {
+        int32 soc = issue == Pwm::ADC_SOCA ? 0 : 1;
         // Reset time-base events
-        regPwm_->etsel.bit.socaen = 0;    
-        regPwm_->etsel.bit.socasel = 0;
+        resetSoc(soc);
         // Set time-base events        
         bit = getEnableEvenBits(event);
         if( bit == 0xffff ) break;
-        regPwm_->etsel.bit.socasel = bit;
-        // Set one the socasel event selected need to be occurred
-        regPwm_->etps.bit.socaprd = 1;
-        // Enable event
-        regPwm_->etsel.bit.socaen = 1;        
+        if(period <= EVENT_PERIOD_MAX)
+        {
+          // Set the number of the event selected need to be occurred, and enable event
+          writeSoc(soc, bit, period, true);
+        }
+        else
+        {
+          // The PWM interrupt must be generated on each the same event
+          if(!isInterrupt(bit, 1)) break;
+          if(!openInterrupt(bit, 1)) break;
+          // Enable event from the interrupt service routine before the last event of the period
+          prescaler_[soc].count = 0;
+          prescaler_[soc].period = period;
+          writeSoc(soc, bit, 1, false);
+        }
         res = true;
       }
-      break;
-      case Pwm::ADC_SOCB:
+      break;      
+      case Pwm::CPU_INT:
       {
-        // Reset time-base events
-        regPwm_->etsel.bit.socben = 0;    
-        regPwm_->etsel.bit.socbsel = 0;
-        // Set time-base events        
+        // The event is changed only for the set interrupt handler
+        if(eventTask_ == NULL) break;
         bit = getEnableEvenBits(event);
         if( bit == 0xffff ) break;
-        regPwm_->etsel.bit.socbsel = bit;
-        // Set one the socasel event selected need to be occurred
-        regPwm_->etps.bit.socbprd = 1;
-        // Enable event
-        regPwm_->etsel.bit.socben = 1;        
-        res = true;
+        if(period > EVENT_PERIOD_MAX) break;
+        if(!isInterrupt(bit, period)) break;
+        res = openInterrupt(bit, period);
       }
       break;      
     }
-    return mutex_.drv.unlock(res);    
+    return mutex_.res.unlock(res);    
   }
   
   /**
@@ -812,117 +1207,1088 @@ public:
       case Pwm::ADC_SOCA:
       {
         // Reset time-base events
-        regPwm_->etsel.bit.socaen = 0;    
-        regPwm_->etsel.bit.socasel = 0;
+        resetSoc(0);
       }
       break;
       case Pwm::ADC_SOCB:
       {
         // Reset time-base events
-        regPwm_->etsel.bit.socben = 0;    
-        regPwm_->etsel.bit.socbsel = 0;
+        resetSoc(1);
+      }
+      break;      
+      case Pwm::CPU_INT:
+      {
+        // The interrupt is still needed by the software prescaler or the burst counter
+        if(isPrescaled() || isBursting()) break;
+        regPwm_->etsel.bit.inten = 0;
       }
       break;      
     }
-    return mutex_.drv.unlock();    
+    return mutex_.res.unlock();    
   }
   
   /**
-   * Initialization.
+   * Sets a handler of the PWM interrupt.
    *
-   * @param sourceClock the CPU oscillator source clock in Hz.   
-   * @return true if no errors.
-   */
-  static bool init(int32 sourceClock)
+   * @param handler a user handler.
+   * @param event   an trigger received event.
+   * @param period  a number of events from 1 to 3 for generating an interrupt.
+   * @return true if the handler has been set successfully.
+   */  
+  virtual bool setInterrupt(::InterruptTask& handler, int32 event, int32 period=1)
+  {
+    if(!isConstructed()) return false;
+    if(period < 1 || EVENT_PERIOD_MAX < period) return false;
+    if(!mutex_.res.lock()) return false;
+    uint16 bit = getEnableEvenBits(event);
+    if( bit == 0xffff ) return mutex_.res.unlock(false);
+    if(!isInterrupt(bit, period)) return mutex_.res.unlock(false);
+    if(!openInterrupt(bit, period)) return mutex_.res.unlock(false);
+    eventTask_ = &handler;
+    return mutex_.res.unlock(true);
+  }
+  
+  /**
+   * Resets the handler of the PWM interrupt.
+   */  
+  virtual void resetInterrupt()
+  {
+    if(!isConstructed()) return;
+    if(!mutex_.res.lock()) return;
+    eventTask_ = NULL;
+    // The interrupt is still needed by the software prescaler or the burst counter
+    if(!isPrescaled() && !isBursting()) closeInterrupt();
+    return mutex_.res.unlock();
+  }
+  
+  /**
+   * Tests if the PWM module has trip-zone submodule.
+   *
+   * @return true if the module has trip-zone submodule.
+   */      
+  virtual bool isTripZoned() const
   {
-    isInitialized_ = 0;
-    for(int32 i=0; i<RESOURCES_NUMBER; i++) lock_[i] = false;
-    // Create the driver Mutex
-    drvMutex_ = new Mutex();
-    if(drvMutex_ == NULL || !drvMutex_->isConstructed() ) return false;
-    // Create the CPU registers maps
-    regSys_ = new (SystemRegister::ADDRESS) SystemRegister();
-    regGpio_ = new (GpioRegister::ADDRESS) GpioRegister();    
-    sysclk_ = getCpuClock(sourceClock);
-    if(sysclk_ <= 0) return false;
-    // Set all ePWMs pins mixed with GPIO[0-11] pins as ePWMs
-    System::eallow();
-    // Enable the internal pullup on the specified pins.
-    regGpio_->gpapud.val &= 0xfffff000;
-    // Configure the GPIO pins as ePWMs output
-    regGpio_->gpamux1.val &= 0xff000000;  
-    regGpio_->gpamux1.val |= 0x00555555;      
-    System::dallow();
-    #ifdef DRIVER_HRPWM
-    uint32 addr;
-    // Default TI SFO Library varaibles initialization
-    for(int32 i=0; i<PWM_CH; i++) 
-    {
-      MEP_ScaleFactor[i] = 0;
-      switch(i)
-      {
-        case  1: addr = PwmRegister::ADDRESS0; break;
-        case  2: addr = PwmRegister::ADDRESS1; break;
-        case  3: addr = PwmRegister::ADDRESS2; break;
-        case  4: addr = PwmRegister::ADDRESS3; break;
-        case  5: addr = PwmRegister::ADDRESS4; break;
-        case  6: addr = PwmRegister::ADDRESS5; break;        
-        default: addr = 0;
-      }       
-      ePWM[i] = reinterpret_cast<EPWM_REGS*>(addr);
-    }
-    #endif // DRIVER_HRPWM
-    isInitialized_ = IS_INITIALIZED;
     return true;
   }
   
   /**
-   * Deinitialization.
-   */
-  static void deinit()
+   * Returns a trip-zone submodule interface.
+   *
+   * @return reference to the trip-zone submodule interface.
+   */      
+  virtual ::Pwm::TripZone& getTripZone()
   {
-    sysclk_ = 0;
-    regSys_ = NULL;
-    regGpio_ = NULL;
-    isInitialized_ = 0;
-    if(drvMutex_ != NULL) delete drvMutex_;
-    for(int32 i=0; i<RESOURCES_NUMBER; i++) lock_[i] = false;
+    return *this;
   }
   
-protected:  
-
   /**
-   * Returns max available frequency of the PWM module.
+   * Returns an action-qualifier submodule interface.
    *
-   * @return max frequency, or ERROR if error occurred.   
-   */        
-  virtual int32 maxFrequency() const = 0;  
+   * @return reference to the action-qualifier submodule interface.
+   */      
+  virtual ::Pwm::ActionQualifier& getActionQualifier()
+  {
+    return *this;
+  }
   
   /**
-   * Returns min available frequency of the PWM module.
+   * Sets an output action on an event.
    *
-   * @return min frequency, or ERROR if error occurred.
-   */
-  virtual int32 minFrequency() const = 0;
+   * @param channel a channel number.
+   * @param event   an action-qualifier event.
+   * @param action  an output action.
+   * @return true if the action has been set successfully.
+   */  
+  virtual bool setQualifier(int32 channel, QualifierEvent event, OutputAction action)
+  {
+    if(!isConstructed() || !isChannel(channel)) return false;
+    if(event < Pwm::AQ_ZERO || Pwm::AQ_CMPB_DOWN < event) return false;
+    if(action < Pwm::OUTPUT_NOTHING || Pwm::OUTPUT_TOGGLE < action) return false;
+    if(!mutex_.res.lock()) return false;
+    // Each event has two bits of the AQCTL register
+    int32 shift = event << 1;
+    uint16 value = regPwm_->aqctl[channel].val & ~(0x0003 << shift);
+    regPwm_->aqctl[channel].val = value | action << shift;
+    return mutex_.res.unlock(true);
+  }
   
   /**
-   * Sets received event.
+   * Returns an output action on an event.
    *
-   * @param event an trigger received event.
-   * @return true if the event has been set successfully.
+   * @param channel a channel number.
+   * @param event   an action-qualifier event.
+   * @return the output action, or ERROR if error has been occurred.
    */  
-  virtual uint16 getEnableEvenBits(int32 event) = 0;
-
+  virtual int32 getQualifier(int32 channel, QualifierEvent event) const
+  {
+    if(!isConstructed() || !isChannel(channel)) return ERROR;
+    if(event < Pwm::AQ_ZERO || Pwm::AQ_CMPB_DOWN < event) return ERROR;
+    int32 shift = event << 1;
+    return regPwm_->aqctl[channel].val >> shift & 0x0003;
+  }
+  
   /**
-   * Tests task has correct values
+   * Resets the output actions of a channel to the counting policy default.
    *
-   * @param task a task.
-   * @return true if the task is correct.
-   */
-  virtual bool isTask(const TaskInterface& task) const
+   * @param channel a channel number.
+   */  
+  virtual void resetQualifiers(int32 channel)
   {
-    float32 duty;  
-    int32 maxFreq, minFreq, freq;
+    if(!isConstructed() || !isChannel(channel)) return;
+    if(!mutex_.res.lock()) return;
+    regPwm_->aqctl[channel].val = getQualifiers(channel);
+    return mutex_.res.unlock();
+  }
+  
+  /**
+   * Forces an output continuously by software.
+   *
+   * @param channel a channel number.
+   * @param action  OUTPUT_LOW, OUTPUT_HIGH, or OUTPUT_NOTHING for releasing the output.
+   * @return true if the output has been forced successfully.
+   */  
+  virtual bool setForce(int32 channel, OutputAction action)
+  {
+    if(!isConstructed() || !isChannel(channel)) return false;
+    if(action < Pwm::OUTPUT_NOTHING || Pwm::OUTPUT_HIGH < action) return false;
+    // No mutex is locked for accessing from an interrupt service routine
+    bool is = Interrupt::globalDisable();
+    if(channel == 0) 
+      regPwm_->aqcsfrc.bit.csfa = action;
+    else
+      regPwm_->aqcsfrc.bit.csfb = action;
+    Interrupt::globalEnable(is);
+    return true;
+  }
+  
+  /**
+   * Sets a trip zone as a source of the module trip.
+   *
+   * @param zone a trip zone number from 1 to 6.
+   * @param mode a trip mode.
+   * @return true if the zone has been set successfully.
+   */  
+  virtual bool setZone(int32 zone, TripMode mode)
+  {
+    if(!isConstructed()) return false;
+    if(zone < 1 || TRIP_ZONES_NUMBER < zone) return false;
+    if(!setTripPin(zone)) return false;
+    if(!mutex_.res.lock()) return false;
+    uint16 cbc = 0x0001 << (zone - 1);
+    uint16 osht = cbc << 8;
+    uint16 value = regPwm_->tzsel.val & ~(cbc | osht);
+    switch(mode)
+    {
+      case Pwm::TRIP_CBC:  value |= cbc;  break;
+      case Pwm::TRIP_OSHT: value |= osht; break;
+      default: return mutex_.res.unlock(false);
+    }
+    System::eallow();
+    regPwm_->tzsel.val = value;
+    System::dallow();
+    return mutex_.res.unlock(true);
+  }
+  
+  /**
+   * Resets a trip zone.
+   *
+   * @param zone a trip zone number from 1 to 6.
+   */  
+  virtual void resetZone(int32 zone)
+  {
+    if(!isConstructed()) return;
+    if(zone < 1 || TRIP_ZONES_NUMBER < zone) return;
+    if(!mutex_.res.lock()) return;
+    uint16 cbc = 0x0001 << (zone - 1);
+    uint16 osht = cbc << 8;
+    System::eallow();
+    regPwm_->tzsel.val &= ~(cbc | osht);
+    System::dallow();
+    return mutex_.res.unlock();
+  }
+  
+  /**
+   * Sets an output action on a trip.
+   *
+   * @param channel a channel number.
+   * @param action  an output action.
+   * @return true if the action has been set successfully.
+   */  
+  virtual bool setAction(int32 channel, TripAction action)
+  {
+    if(!isConstructed()) return false;
+    if(channel < 0 || CHANNELS_NUMBER <= channel) return false;
+    if(action < Pwm::TRIP_HIGH_Z || Pwm::TRIP_NOTHING < action) return false;
+    if(!mutex_.res.lock()) return false;
+    System::eallow();
+    if(channel == 0) 
+      regPwm_->tzctl.bit.tza = action;
+    else
+      regPwm_->tzctl.bit.tzb = action;
+    System::dallow();
+    return mutex_.res.unlock(true);
+  }
+  
+  /**
+   * Sets a trip interrupt handler.
+   *
+   * @param handler a user handler.
+   * @return true if the handler has been set successfully.
+   */  
+  virtual bool setHandler(::InterruptTask& handler)
+  {
+    if(!isConstructed()) return false;
+    if(!mutex_.res.lock()) return false;
+    if(tripInt_ == NULL) 
+    {
+      tripInt_ = Interrupt::create(*this, getTripSource());
+      if(tripInt_ == NULL) return mutex_.res.unlock(false);
+    }
+    tripInt_->disable();
+    tripTask_ = &handler;
+    System::eallow();
+    // Clear a trip interrupt flag which might be set before
+    regPwm_->tzclr.val = 0x0001;
+    // Enable both cycle-by-cycle and one-shot trip interrupts
+    regPwm_->tzeint.val = 0x0006;
+    System::dallow();
+    tripInt_->enable(true);
+    return mutex_.res.unlock(true);
+  }
+  
+  /**
+   * Resets the trip interrupt handler.
+   */  
+  virtual void resetHandler()
+  {
+    if(!isConstructed()) return;
+    if(!mutex_.res.lock()) return;
+    System::eallow();
+    regPwm_->tzeint.val = 0x0000;
+    System::dallow();
+    if(tripInt_ != NULL) 
+    {
+      tripInt_->disable();
+      delete tripInt_;
+    }
+    tripInt_ = NULL;
+    tripTask_ = NULL;
+    return mutex_.res.unlock();
+  }
+  
+  /**
+   * Forces a trip by software.
+   *
+   * @param mode a trip mode.
+   */  
+  virtual void force(TripMode mode=TRIP_OSHT)
+  {
+    if(!isConstructed()) return;
+    System::eallow();
+    regPwm_->tzfrc.val = getTripBits(mode);
+    System::dallow();
+  }
+  
+  /**
+   * Tests if a trip has been occurred.
+   *
+   * @param mode a trip mode.
+   * @return true if the trip flag is set.
+   */  
+  virtual bool isTripped(TripMode mode) const
+  {
+    if(!isConstructed()) return false;
+    return (regPwm_->tzflg.val & getTripBits(mode)) == 0 ? false : true;
+  }
+  
+  /**
+   * Clears a trip.
+   *
+   * @param mode a trip mode.
+   */  
+  virtual void clear(TripMode mode)
+  {
+    if(!isConstructed()) return;
+    System::eallow();
+    regPwm_->tzclr.val = getTripBits(mode);
+    System::dallow();
+  }
+  
+  /**
+   * The method with self context.
+   *
+   * The method is the PWM and the trip interrupt service routine of the module.
+   */  
+  virtual void handler()
+  {
+    if(regPwm_->etflg.bit.intb == 1)
+    {
+      // Clear the interrupt flag before calling the handler for not losing next events
+      regPwm_->etclr.val = 0x0001;
+      prescale();
+      countBurst();
+      if(eventTask_ != NULL) eventTask_->handler();
+    }
+    if(regPwm_->tzflg.bit.intb == 1)
+    {
+      if(tripTask_ != NULL) tripTask_->handler();
+      // Clear the trip interrupt flag for generating next interrupts
+      System::eallow();
+      regPwm_->tzclr.val = 0x0001;
+      System::dallow();
+    }
+  }
+  
+  /**
+   * Tests if this object has been constructed.
+   *
+   * @return true if object has been constructed successfully.
+   */    
+  virtual bool isConstructed() const
+  {
+    return this->Parent::isConstructed();
+  }
+  
+  /**
+   * Initialization.
+   *
+   * @param sourceClock the CPU oscillator source clock in Hz.   
+   * @return true if no errors.
+   */
+  static bool init(int32 sourceClock)
+  {
+    isInitialized_ = 0;
+    for(int32 i=0; i<RESOURCES_NUMBER; i++) 
+    {
+      lock_[i] = false;
+      controller_[i] = NULL;
+      dmaLock_[i] = false;
+    }
+    resetCalibration();
+    // Create the driver Mutex
+    drvMutex_ = new Mutex();
+    if(drvMutex_ == NULL || !drvMutex_->isConstructed() ) return false;
+    // Create the CPU registers maps
+    regSys_ = new (SystemRegister::ADDRESS) SystemRegister();
+    regGpio_ = new (GpioRegister::ADDRESS) GpioRegister();    
+    sysclk_ = getCpuClock(sourceClock);
+    if(sysclk_ <= 0) return false;
+    // The one-shot pulse width unit is 8 SYSCLKOUT cycles
+    pulse_.set(sysclk_, 8);
+    // Set all ePWMs pins mixed with GPIO[0-11] pins as ePWMs
+    System::eallow();
+    // Enable the internal pullup on the specified pins.
+    regGpio_->gpapud.val &= 0xfffff000;
+    // Configure the GPIO pins as ePWMs output
+    regGpio_->gpamux1.val &= 0xff000000;  
+    regGpio_->gpamux1.val |= 0x00555555;      
+    System::dallow();
+    // The DRIVER_PWM_DMA definition is not set by default, and has to be passed to the compiler 
+    // by a project which uses the sinusoidal PWM generator, as all ePWM registers are re-mapped 
+    // to the DMA accessible Peripheral Frame 3
+    #ifdef DRIVER_PWM_DMA
+    regDma_ = new (DmaRegister::ADDRESS) DmaRegister();
+    System::eallow();
+    // Enable the DMA clock, and re-map the ePWM registers for the DMA access
+    regSys_->pclkcr3.bit.dmaenclk = 1;
+    regSys_->mapcnf.bit.mapepwm = 1;
+    System::dallow();
+    #endif // DRIVER_PWM_DMA
+    #ifdef DRIVER_HRPWM
+    // Default TI SFO Library varaibles initialization
+    for(int32 i=0; i<PWM_CH; i++) 
+    {
+      MEP_ScaleFactor[i] = 0;
+      // The zero element is not used by the library
+      ePWM[i] = reinterpret_cast<EPWM_REGS*>( i == 0 ? 0 : getAddress(i - 1) );
+    }
+    #endif // DRIVER_HRPWM
+    isInitialized_ = IS_INITIALIZED;
+    return true;
+  }
+  
+  /**
+   * Deinitialization.
+   */
+  static void deinit()
+  {
+    sysclk_ = 0;
+    regSys_ = NULL;
+    regGpio_ = NULL;
+    regDma_ = NULL;
+    isInitialized_ = 0;
+    if(drvMutex_ != NULL) delete drvMutex_;
+    for(int32 i=0; i<RESOURCES_NUMBER; i++) 
+    {
+      lock_[i] = false;
+      controller_[i] = NULL;
+      dmaLock_[i] = false;
+    }
+  }
+
+  /**
+   * Executes one step of the high resolution calibration.
+   *
+   * @return true if a calibration step has been executed.
+   */
+  static bool calibrate()
+  {
+    #ifdef DRIVER_HRPWM
+    if(isInitialized_ != IS_INITIALIZED) return false;
+    // The driver mutex excludes deleting the modules and concurrent SFO calls
+    if(!drvMutex_->lock()) return false;
+    bool res = false;
+    for(int32 i=0; i<RESOURCES_NUMBER; i++)
+    {
+      PwmController* pwm = controller_[cursor_];
+      if(pwm == NULL || !pwm->isHiRes_) 
+      {
+        nextCalibration();
+        continue;
+      }
+      int16 num = cursor_ + 1;
+      int16 prev = MEP_ScaleFactor[num];
+      int16 status = SFO_MepEn_V5(num);
+      steps_++;
+      res = true;
+      if(status == SFO_INCOMPLETE) break;
+      int16 mep = MEP_ScaleFactor[num];
+      if(status == SFO_COMPLETE && 0 < mep && mep <= MAX_MEP)
+      {
+        int32 drift = 0 < prev && prev <= MAX_MEP ? mep - prev : 0;
+        if(drift < 0) drift = -drift;
+        if(drift > drift_) drift_ = drift;
+        if(drift > calibration_.maxDrift) calibration_.maxDrift = drift;
+        calibration_.mep[cursor_] = mep;
+        // Initialize MEP_ScaleFactor[0] with a typical MEP seed value for SFO_MepEn_V5 
+        MEP_ScaleFactor[0] = mep;
+        pwm->refreshHighResolution(mep);
+      }
+      else
+      {
+        calibration_.errors++;
+      }
+      calibrated_++;
+      nextCalibration();
+      break;
+    }
+    return drvMutex_->unlock(res);
+    #else  // DRIVER_HRPWM
+    return false;
+    #endif // DRIVER_HRPWM
+  }
+
+  /**
+   * Returns the high resolution calibration report.
+   *
+   * @param report a report to be filled.
+   * @return true if the report has been filled successfully.
+   */
+  static bool getCalibration(Calibration& report)
+  {
+    if(isInitialized_ != IS_INITIALIZED) return false;
+    if(!drvMutex_->lock()) return false;
+    report = calibration_;
+    return drvMutex_->unlock(true);
+  }
+  
+protected:  
+
+  /**
+   * Returns max available frequency of the PWM module.
+   *
+   * @return max frequency, or ERROR if error occurred.   
+   */        
+  virtual int32 maxFrequency() const = 0;  
+  
+  /**
+   * Returns min available frequency of the PWM module.
+   *
+   * @return min frequency, or ERROR if error occurred.
+   */
+  virtual int32 minFrequency() const = 0;
+  
+  /**
+   * Sets received event.
+   *
+   * @param event an trigger received event.
+   * @return true if the event has been set successfully.
+   */  
+  virtual uint16 getEnableEvenBits(int32 event) = 0;
+
+  /**
+   * Returns the default action-qualifier control of a channel.
+   *
+   * @param channel a channel number.
+   * @return the AQCTL register value.
+   */  
+  virtual uint16 getQualifiers(int32 channel) const = 0;
+
+  /**
+   * Returns the period boundary event where the outputs are low.
+   *
+   * @return the CTR_ZERO or CTR_PRD event.
+   */  
+  virtual int32 getBoundaryEvent() const = 0;
+
+  /**
+   * Returns the high resolution edge mode of the counting policy.
+   *
+   * @return the HRCNFG register EDGMODE bits, or ERROR if high resolution is not supported.
+   */  
+  virtual int32 getEdgeMode() const
+  {
+    return ERROR;
+  }
+
+  /**
+   * Returns an edge delay in Q16 format.
+   *
+   * @param clocks a delay in time-base clocks.
+   * @return the delay in time-base clocks in Q16 format.
+   */  
+  static uint32 getDelay(float32 clocks)
+  {
+    return static_cast<uint32>(clocks * 65536.0f + 0.5f);
+  }
+
+  /**
+   * Tests if the micro edge positioner controls the duty of the channel A.
+   *
+   * @return true if the duty is in high resolution.
+   */  
+  bool isHiResDuty() const
+  {
+    #ifdef DRIVER_HRPWM
+    return isHiRes_ && !isHiResPhase_ ? true : false;
+    #else  // DRIVER_HRPWM
+    return false;
+    #endif // DRIVER_HRPWM
+  }
+
+  /**
+   * Calculates the period and compare values of a task.
+   *
+   * The method fills the time-base period, counter-compare and 
+   * the fast duty updating scaling values of a register image.
+   *
+   * @param task  a correct task.
+   * @param image a register image.
+   */
+  virtual void compileTask(const TaskInterface& task, Image& image) const = 0;
+
+  /**
+   * Returns the count of time-base clocks of a task period.
+   *
+   * The count is rounded up, and the frequency fractional part is taken 
+   * into account, thus the real frequency is not higher than the task one.
+   *
+   * @param task  a correct task.
+   * @param clock a time-base clock of the task in Hz.
+   * @return the count of clocks.
+   */
+  static uint32 getTaskCount(const TaskInterface& task, int32 clock)
+  {
+    uint64 freq = static_cast<uint64>( task.getFrequency() ) << 16 | task.getFraction();
+    uint64 clk = static_cast<uint64>(clock) << 16;
+    return static_cast<uint32>( clk / freq + (clk % freq != 0 ? 1 : 0) );
+  }
+
+  /**
+   * Returns a frequency of the integer and fractional parts.
+   *
+   * @param frequency a frequency integer part in Hz.
+   * @param fraction  a frequency fractional part in 1/65536 Hz.
+   * @return the frequency in Hz.
+   */
+  static float32 getHertz(int32 frequency, uint16 fraction)
+  {
+    return static_cast<float32>(frequency) + static_cast<float32>(fraction) / 65536.0f;
+  }
+
+  /**
+   * Compiles a task into a register image.
+   *
+   * This is important, the method must be called in the resource mutex locked code section.
+   *
+   * @param task  a task for compiling.
+   * @param image a register image to be filled.
+   * @return true if the task has been compiled successfully.
+   */
+  bool compileImage(const TaskInterface& task, Image& image) const
+  {
+    if(!isTask(task)) return false;
+    image.clock = getTaskClock(task.getFrequency(), image.divider);
+    if(image.clock == ERROR) return false;
+    image.count = getCountPolicy();
+    image.task.frequency = task.getFrequency();
+    image.task.fraction = task.getFraction();
+    for(int32 i=0; i<CHANNELS_NUMBER; i++) 
+    {
+      image.task.duty[i] = task.getDuty(i);
+      image.aqctl[i] = regPwm_->aqctl[i].val;
+    }
+    image.cmpahr = 0;
+    image.delay = 0;
+    compileTask(task, image);
+    #ifdef DRIVER_HRPWM
+    if(isHiResDuty()) compileHighResolution(image);
+    #endif // DRIVER_HRPWM
+    return true;
+  }
+
+  /**
+   * Writes a register image to the registers.
+   *
+   * This is important, the method must be called in the resource mutex locked code section.
+   *
+   * @param image a register image compiled by the PWM module.
+   * @return true if the image has been applied successfully.
+   */
+  bool applyImage(const Image& image)
+  {
+    if(!isImage(image)) return false;
+    // Write values to the registers in one load window with disabled global interrupts,
+    // thus the period and compare values are loaded together, and the interrupt service 
+    // routine does not update the duty by the scaling being written
+    bool is = Interrupt::globalDisable();
+    if(!waitWindow())
+    {
+      Interrupt::globalEnable(is);
+      return false;
+    }
+    writeImage(image);
+    Interrupt::globalEnable(is);
+    return true;
+  }
+
+  /**
+   * Tests if a register image may be applied to the PWM module.
+   *
+   * @param image a register image.
+   * @return true if the image is compiled for the PWM module.
+   */
+  bool isImage(const Image& image) const
+  {
+    if(image.clock != tbclk_ && !isAutoClock_) return false;
+    return image.count == getCountPolicy() ? true : false;
+  }
+
+  /**
+   * Writes a register image to the registers.
+   *
+   * This is important, the method must be called in the resource mutex locked 
+   * and interrupts disabled code section.
+   *
+   * @param image a correct register image.
+   */
+  void writeImage(const Image& image)
+  {
+    if(image.clock != tbclk_) writeClock(image);
+    regPwm_->tbprd.val = image.tbprd;
+    for(int32 i=0; i<CHANNELS_NUMBER; i++)
+    {
+      regPwm_->cmp[i].val = image.cmp[i];
+      regPwm_->aqctl[i].val = image.aqctl[i];
+    }
+    #ifdef DRIVER_HRPWM
+    if(isHiResDuty()) regPwm_->cmpahr.bit.cmpahr = image.cmpahr;
+    #endif // DRIVER_HRPWM
+    // Set scaling of the fast duty updating
+    compare_.base = image.base;
+    compare_.scale = image.scale;
+    compare_.sign = image.sign;
+    delay_ = image.delay;
+    task_ = image.task;
+  }
+
+  /**
+   * Reads the register image of the current task.
+   *
+   * @param image a register image to be filled.
+   */
+  void readImage(Image& image) const
+  {
+    image.clock = tbclk_;
+    image.divider = regPwm_->tbctl.bit.clkdiv << 3 | regPwm_->tbctl.bit.hspclkdiv;
+    image.count = getCountPolicy();
+    image.tbprd = regPwm_->tbprd.val;
+    image.task.frequency = task_.getFrequency();
+    image.task.fraction = task_.getFraction();
+    for(int32 i=0; i<CHANNELS_NUMBER; i++)
+    {
+      image.cmp[i] = regPwm_->cmp[i].val;
+      image.aqctl[i] = regPwm_->aqctl[i].val;
+      image.task.duty[i] = task_.getDuty(i);
+    }
+    image.cmpahr = regPwm_->cmpahr.bit.cmpahr;
+    image.delay = delay_;
+    image.base = compare_.base;
+    image.scale = compare_.scale;
+    image.sign = compare_.sign;
+  }
+
+  /**
+   * Returns the high resolution mode of the module.
+   *
+   * @return the mode, where bit 0 is the duty control, and bit 1 is the phase control.
+   */
+  uint16 getHighResolutionMode() const
+  {
+    uint16 mode = 0;
+    #ifdef DRIVER_HRPWM
+    if(isHiRes_) mode |= isHiResPhase_ ? 0x2 : 0x1;
+    #endif // DRIVER_HRPWM
+    return mode;
+  }
+
+  /**
+   * Returns the time-base clock of a task frequency.
+   *
+   * @param frequency a task frequency in Hz.
+   * @param divider   the TBCTL register dividers bits of the clock.
+   * @return the time-base clock in Hz, or ERROR if no clock might be selected.
+   */
+  int32 getTaskClock(int32 frequency, uint16& divider) const
+  {
+    if(!isAutoClock_)
+    {
+      divider = regPwm_->tbctl.bit.clkdiv << 3 | regPwm_->tbctl.bit.hspclkdiv;
+      return tbclk_;
+    }
+    if(frequency <= 0) return ERROR;
+    // Max count of time-base clocks in one period
+    int32 max = getCountPolicy() == Pwm::UPDOWN ? 2 * 0xffff : 0xffff + 1;
+    // The high resolution duty is available only for TBCLK=SYSCLKOUT
+    int32 last = isHiResDuty() ? 1 : CLOCK_DIVIDER_MAX;
+    int32 best = ERROR;
+    for(int32 i=0; i<8; i++)
+    {
+      for(int32 j=0; j<8; j++)
+      {
+        // The clock is SYSCLKOUT / (2^CLKDIV * 2*HSPCLKDIV), where zero HSPCLKDIV divides by 1
+        int32 div = (0x1 << i) * (j == 0 ? 1 : 2 * j);
+        if(div > last) continue;
+        if(best != ERROR && div >= best) continue;
+        int32 clock = sysclk_ / div;
+        int32 count = clock / frequency + (clock % frequency != 0 ? 1 : 0);
+        if(count > max) continue;
+        best = div;
+        divider = i << 3 | j;
+      }
+    }
+    return best == ERROR ? ERROR : sysclk_ / best;
+  }
+
+  /**
+   * Writes the time-base clock dividers of a register image.
+   *
+   * The dividers are not shadowed, thus the current period is finished with new clock.
+   * This is important, the method must be called in the resource mutex locked 
+   * and interrupts disabled code section.
+   *
+   * @param image a correct register image.
+   */
+  void writeClock(const Image& image)
+  {
+    regPwm_->tbctl.bit.clkdiv = image.divider >> 3 & 0x7;
+    regPwm_->tbctl.bit.hspclkdiv = image.divider & 0x7;
+    tbclk_ = image.clock;
+    setTime();
+    // Recalculate the dead-band delays for new clock
+    regPwm_->dbred.bit.del = getDeadBandClocks(deadBand_.rising);
+    regPwm_->dbfed.bit.del = getDeadBandClocks(deadBand_.falling);
+  }
+
+  /**
+   * Returns the max time-base clock of the module.
+   *
+   * @return the clock in Hz.
+   */
+  int32 getMaxClock() const
+  {
+    return isAutoClock_ ? sysclk_ : tbclk_;
+  }
+
+  /**
+   * Returns the min time-base clock of the module.
+   *
+   * @return the clock in Hz.
+   */
+  int32 getMinClock() const
+  {
+    if(!isAutoClock_) return tbclk_;
+    // The high resolution duty is available only for TBCLK=SYSCLKOUT
+    return isHiResDuty() ? sysclk_ : sysclk_ / CLOCK_DIVIDER_MAX;
+  }
+
+  /**
+   * Calculates the time conversion factors of the time-base clock.
+   *
+   * The method must be called each time when the time-base clock is changed.
+   */
+  void setTime()
+  {
+    time_.set(tbclk_, 1);
+  }
+
+  /**
+   * Returns a count of time-base clocks of a time.
+   *
+   * @param time a time in ns.
+   * @return the count of time-base clocks rounded to nearest.
+   */
+  uint32 getClocks(uint32 time) const
+  {
+    return static_cast<uint32>( (static_cast<uint64>(time) * time_.clocks + 0x80000000) >> 32 );
+  }
+
+  /**
+   * Returns a time of time-base clocks.
+   *
+   * @param clocks a count of time-base clocks.
+   * @return the time in ns rounded to nearest.
+   */
+  uint32 getTime(uint32 clocks) const
+  {
+    return static_cast<uint32>( (static_cast<uint64>(clocks) * time_.ns + 0x8000) >> 16 );
+  }
+
+  /**
+   * Returns a dead-band delay register value of a time.
+   *
+   * @param time a time in ns.
+   * @return the DBRED or DBFED register value.
+   */
+  uint16 getDeadBandClocks(float32 time) const
+  {
+    uint32 value = getClocks( static_cast<uint32>(time + 0.5f) );
+    // The delay counters are 10-bit
+    return static_cast<uint16>( value <= 0x3ff ? value : 0x3ff );
+  }
+
+  /**
+   * Returns a number of phase steps in one time-base clock.
+   *
+   * @return the micro edge positioner steps if the phase is in high resolution, 
+   *         one if it is not, or ERROR if error has been occurred.
+   */
+  int32 getStepsPerClock() const
+  {
+    #ifdef DRIVER_HRPWM
+    if(isHiResPhase_) return getMep();
+    #endif // DRIVER_HRPWM
+    return 1;
+  }
+
+  /**
+   * Returns a number of phase steps of a time.
+   *
+   * @param time the PWN signals shift time during synchronization in ns.
+   * @return the phase steps.
+   */
+  int32 getPhaseSteps(int32 time) const
+  {
+    int32 steps = getStepsPerClock();
+    if(steps == ERROR) steps = 1;
+    // The time-base clocks in Q32 format are reduced to Q24 for multiplying by up to 8-bit steps
+    uint64 value = static_cast<uint64>(time) * time_.clocks >> 8;
+    value = value * static_cast<uint32>(steps) + 0x800000;
+    return static_cast<int32>(value >> 24);
+  }
+
+  /**
+   * Splits phase steps to the phase registers values.
+   *
+   * @param steps   the phase steps.
+   * @param tbphs   the TBPHS register value.
+   * @param tbphshr the TBPHSHR register high-resolution bits value.
+   */
+  void splitPhase(int32 steps, uint16& tbphs, uint16& tbphshr) const
+  {
+    int32 per = getStepsPerClock();
+    if(per == ERROR) per = 1;
+    int32 count = steps / per;
+    tbphs = count <= 0xffff ? count : 0xffff;
+    tbphshr = count <= 0xffff ? steps - count * per : 0;
+  }
+
+  /**
+   * Writes phase steps to the phase registers.
+   *
+   * @param steps the phase steps.
+   */
+  void writePhase(int32 steps)
+  {
+    uint16 tbphs, tbphshr;
+    splitPhase(steps, tbphs, tbphshr);
+    bool is = disable();
+    #ifdef DRIVER_HRPWM
+    if(isHiResPhase_) 
+    {
+      // The TBPHS:TBPHSHR pair is written by one 32-bit access, thus a synchronization never loads a half of the phase
+      volatile uint32* pair = reinterpret_cast<volatile uint32*>(&regPwm_->tbphshr.val);
+      *pair = static_cast<uint32>(tbphs) << 16 | static_cast<uint32>(tbphshr) << 8;
+      enable(is);
+      return;
+    }
+    #endif // DRIVER_HRPWM
+    regPwm_->tbphs.val = tbphs;
+    enable(is);
+  }
+
+  /**
+   * Returns a number of time-base clocks before next counter-equal-zero event.
+   *
+   * @return the clocks number, or ERROR if the time-base counter is stopped.
+   */
+  int32 getLoadDistance() const
+  {
+    if(regPwm_->tbctl.bit.ctrmode == Tbctl::COUNT_FREEZE) return ERROR;
+    int32 ctr = regPwm_->tbctr.val;
+    int32 prd = regPwm_->tbprd.val;
+    switch(getCountPolicy())
+    {
+      case Pwm::UP   : return prd - ctr + 1;
+      case Pwm::DOWN : return ctr;
+      default        : return regPwm_->tbsts.bit.ctrdir == 1 ? prd + prd - ctr : ctr;
+    }
+  }
+
+  /**
+   * Returns a compare value of a duty.
+   *
+   * @param duty a duty in Q15 format, where 0x8000 is 100 percentages, and greater values are 100 percentages.
+   * @return the compare value.
+   */
+  uint16 getCompare(uint16 duty) const
+  {
+    // Saturate the duty to 0x8000 without branching, thus the compare is never beyond the period
+    int32 over = static_cast<int32>(duty) - 0x8000;
+    over &= ~(over >> 31);
+    uint32 limited = static_cast<uint32>(duty) - static_cast<uint32>(over);
+    // The product is less than 2^32 as a scale is no more than 0x10000 and a duty is 0x8000
+    int32 value = static_cast<int32>(compare_.scale * limited >> 15);
+    // Negate the value for inverse compare without branching
+    value = compare_.base + ((value ^ compare_.sign) - compare_.sign);
+    // Saturate negative values to zero without branching
+    value &= ~(value >> 31);
+    return static_cast<uint16>(value);
+  }
+
+  /**
+   * Waits a window for writing one module before next counter-equal-zero event.
+   *
+   * The window does not exist if the time between the counter-equal-zero events 
+   * is not longer than the writing time, and the waiting is broken if the window 
+   * has not been found before two periods elapsed. 
+   * This is important, the method must be called in the global interrupts disabled code section.
+   *
+   * @return true if the window has been found, or the time-base counter is stopped.
+   */
+  bool waitWindow() const
+  {
+    int32 guard = getWindowGuard(tbclk_);
+    int32 dist = getLoadDistance();
+    // A stopped module loads shadow registers when it will be started
+    if(dist == ERROR) return true;
+    if(!isWindow()) return false;
+    int32 wraps = 0;
+    while(dist <= guard)
+    {
+      int32 prev = dist;
+      dist = getLoadDistance();
+      if(dist == ERROR) return true;
+      // Count zero events for breaking the waiting
+      if(dist > prev) wraps++;
+      if(wraps > 2) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Tests if the current period has a window for writing one module.
+   *
+   * @return true if the time between the counter-equal-zero events is longer than the writing time.
+   */
+  bool isWindow() const
+  {
+    return getLoadPeriod(regPwm_->tbprd.val, getCountPolicy()) > getWindowGuard(tbclk_);
+  }
+
+  /**
+   * Tests if the period of a register image has a window for writing one module.
+   *
+   * @param image a register image compiled by the PWM module.
+   * @return true if the time between the counter-equal-zero events is longer than the writing time.
+   */
+  bool isWindow(const Image& image) const
+  {
+    return getLoadPeriod(image.tbprd, image.count) > getWindowGuard(image.clock);
+  }
+
+  /**
+   * Returns a number of time-base clocks of writing one module.
+   *
+   * @param clock a time-base clock frequency.
+   * @return the clocks number.
+   */
+  int32 getWindowGuard(int32 clock) const
+  {
+    return WRITING_CYCLES / (sysclk_ / clock) + 1;
+  }
+
+  /**
+   * Returns a number of time-base clocks between two counter-equal-zero events.
+   *
+   * @param tbprd a period register value.
+   * @param count a counting policy.
+   * @return the clocks number.
+   */
+  static int32 getLoadPeriod(uint16 tbprd, Count count)
+  {
+    int32 prd = tbprd;
+    return count == Pwm::UPDOWN ? prd + prd : prd + 1;
+  }
+
+  /**
+   * Waits next counter-equal-zero event when the shadow registers are loaded.
+   *
+   * @return true if the event has been occurred, or false if the time-base counter is stopped.
+   */
+  bool waitLoad() const
+  {
+    int32 ctr = regPwm_->tbctr.val;
+    uint16 dir = regPwm_->tbsts.bit.ctrdir;
+    while(regPwm_->tbctl.bit.ctrmode != Tbctl::COUNT_FREEZE)
+    {
+      int32 prev = ctr;
+      uint16 down = dir == 0 ? 1 : 0;
+      ctr = regPwm_->tbctr.val;
+      dir = regPwm_->tbsts.bit.ctrdir;
+      switch(getCountPolicy())
+      {
+        // The counter is reset to zero after the period
+        case Pwm::UP   : if(ctr < prev) return true; break;
+        // The counter is loaded with the period after zero
+        case Pwm::DOWN : if(ctr > prev) return true; break;
+        // The counter starts counting up at zero
+        default        : if(down == 1 && dir == 1) return true; break;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Tests task has correct values
+   *
+   * @param task a task.
+   * @return true if the task is correct.
+   */
+  virtual bool isTask(const TaskInterface& task) const
+  {
+    float32 duty;  
+    int32 maxFreq, minFreq, freq;
     if(task.getChannelsNumber() > CHANNELS_NUMBER) return false;
     maxFreq = maxFrequency();
     if(maxFreq == ERROR) return false;    
@@ -931,6 +2297,7 @@ protected:
     freq = task.getFrequency();
     if(freq == ERROR) return false;
     if(freq < minFreq || freq > maxFreq) return false;
+    if(freq == maxFreq && task.getFraction() != 0) return false;
     for(int32 i=0; i<CHANNELS_NUMBER; i++)
     {
       duty = task.getDuty(i);
@@ -956,37 +2323,44 @@ protected:
   #ifdef DRIVER_HRPWM
   
   /**
-   * Starts generating the tasked wave of the PWM module in high resolution.
-   */
-  virtual void startHighResolution()
-  {
-    if(not isHiRes_) return;
-    uint16 cmphr;
-    // Set timer period    
-    int32 pwmclk = task_.getFrequency();    
-    // Rounding up real count of timer-base clocks which wishes to be loaded
-    int32 count = tbclk_ / pwmclk + (tbclk_ % pwmclk != 0 ? 1 : 0);
-    float32 prd = static_cast<float32>( count );
-    float32 mep = static_cast<float32>( getMep() );
-    float32 duty = task_.getDuty(0);      
-    if(mep != ERROR || duty == ERROR)
-    {
-      float32 value = duty * prd / 100.0f;
-      value = value - static_cast<float32>( static_cast<int32>(value) );
-      value = value * mep + 1.5;
-      cmphr = static_cast<uint16>(value);
-      // Write values to the registers in iterrupts disable mode
-      // for possibility to call the method in an interrupt handler
-      bool is = disable();      
-      regPwm_->cmpahr.bit.cmpahr = cmphr;       
-      enable(is);
-      // TODO: Here the HRPWM capability is enable, and updating has to be.
-      // But, the TI SFO_MepEn_V5 fuction always returns SFO_INCOMPLETE state.
-      // Thus, when the problem is solved, the step will be uncommented, and,
-      // also probably, a background task is a BOOS thread will be written
-      // for dynamical updating the MEP.
-      // mep = static_cast<float32>( updatedMep() );      
-    }
+   * Calculates the high resolution compare value of a register image.
+   *
+   * @param image a register image with the calculated edge delay.
+   */
+  void compileHighResolution(Image& image) const
+  {
+    int32 mep = getMep();
+    if(mep == ERROR) return;
+    image.cmpahr = getMepCompare(image.delay, mep);
+  }
+
+  /**
+   * Rewrites the high resolution compare value with new MEP Scale Factor.
+   *
+   * The method is called by the calibration service in the driver mutex locked 
+   * code section. The CMPAHR register is written by one write, and it is loaded
+   * from the shadow register when the time-base counter is equal to zero.
+   *
+   * @param mep new MEP Scale Factor.
+   */
+  void refreshHighResolution(int32 mep)
+  {
+    if(isHiResPhase_) return;
+    regPwm_->cmpahr.bit.cmpahr = getMepCompare(delay_, mep);
+  }
+
+  /**
+   * Returns the CMPAHR register value.
+   *
+   * @param delay an edge delay in time-base clocks in Q16 format.
+   * @param mep   MEP Scale Factor.
+   * @return the CMPAHR register value.
+   */
+  static uint16 getMepCompare(uint32 delay, int32 mep)
+  {
+    // The value is rounded, and one MEP step is added as TI recommends 
+    uint32 value = ( ( delay * static_cast<uint32>(mep) + 0x8000 ) >> 16 ) + 1;
+    return static_cast<uint16>( value <= 0xff ? value : 0xff );
   }
   
   /** 
@@ -998,7 +2372,9 @@ protected:
   {
     // This is important to lock driver mutex for locking all resources access
     if(!mutex_.drv.lock()) return ERROR;    
-    int16 mep = MEP_ScaleFactor[0];
+    // Use the calibrated value of the module, or the seed value if it has not been calibrated
+    int16 mep = MEP_ScaleFactor[index_ + 1];
+    if(mep <= 0 || mep > MAX_MEP) mep = MEP_ScaleFactor[0];
     return (0 < mep && mep <= MAX_MEP) ? mutex_.drv.unlock(mep) : mutex_.drv.unlock(ERROR);
   }
 
@@ -1087,21 +2463,12 @@ private:
   bool construct(int32 clock)
   {
     Toggle* key;  
-    uint32 addr;
     if(isInitialized_ != IS_INITIALIZED) return false;
     if(!mutex_.drv.isConstructed()) return false;    
     if(!mutex_.res.isConstructed()) return false;
     if(!mutex_.drv.lock()) return false;    
-    switch(index_)
-    {
-      case  0: addr = PwmRegister::ADDRESS0; break;
-      case  1: addr = PwmRegister::ADDRESS1; break;
-      case  2: addr = PwmRegister::ADDRESS2; break;
-      case  3: addr = PwmRegister::ADDRESS3; break;
-      case  4: addr = PwmRegister::ADDRESS4; break;
-      case  5: addr = PwmRegister::ADDRESS5; break;        
-      default: return mutex_.drv.unlock(false);
-    }    
+    uint32 addr = getAddress(index_);
+    if(addr == 0) return mutex_.drv.unlock(false);
     if(lock_[index_] == true) return mutex_.drv.unlock(false);
     regPwm_ = new (addr) PwmRegister();
     // Dead-band keys initialization
@@ -1119,6 +2486,9 @@ private:
     if(key == NULL || !key->isConstructed()) return mutex_.drv.unlock(false);
     // Calculate dividers for TBCLK
     if(clock < 0) return mutex_.drv.unlock(false);
+    // The auto clock mode is started with TBCLK=SYSCLKOUT
+    isAutoClock_ = clock == CLOCK_AUTO ? true : false;
+    if(isAutoClock_) clock = sysclk_;
     int32 div, div0, div1;
     tbclk_ = sysclk_;    
     div = tbclk_ / clock;
@@ -1223,7 +2593,9 @@ private:
       case 14: div1 = 7; break;
       default: return mutex_.drv.unlock(false);
     }    
+    setTime();
     lock_[index_] = true;
+    controller_[index_] = this;
     // Set strat settings
     clockOn(true);    
     // Set TBCLK frequency dividers
@@ -1247,6 +2619,9 @@ private:
     // Set CMPA and CMPB are loaded when CTR equals to zero
     regPwm_->cmpctl.bit.loadamode = Cmpctl::LOAD_CTR_EQ_ZERO;
     regPwm_->cmpctl.bit.loadbmode = Cmpctl::LOAD_CTR_EQ_ZERO;     
+    // Set AQCSFRC is loaded immediately for fast output overrides
+    regPwm_->aqcsfrc.val = 0;
+    regPwm_->aqsfrc.bit.rldcsf = Aqsfrc::LOAD_IMMEDIATE;
     #ifdef DRIVER_HRPWM
     mutex_.drv.unlock();
     return updatedMep() != ERROR ? true : false;
@@ -1255,6 +2630,294 @@ private:
     #endif // DRIVER_HRPWM
   }
   
+  /** 
+   * Returns the registers address of a PWM module.
+   *
+   * @param index an index of a PWM module.
+   * @return the registers address, or zero if the index is wrong.
+   */    
+  static uint32 getAddress(int32 index)
+  {
+    switch(index)
+    {
+      // The ePWM registers are re-mapped on the initialization if DRIVER_PWM_DMA is defined
+      #ifdef DRIVER_PWM_DMA
+      case  0: return PwmRegister::REMAP_ADDRESS0;
+      case  1: return PwmRegister::REMAP_ADDRESS1;
+      case  2: return PwmRegister::REMAP_ADDRESS2;
+      case  3: return PwmRegister::REMAP_ADDRESS3;
+      case  4: return PwmRegister::REMAP_ADDRESS4;
+      case  5: return PwmRegister::REMAP_ADDRESS5;
+      #else  // DRIVER_PWM_DMA
+      case  0: return PwmRegister::ADDRESS0;
+      case  1: return PwmRegister::ADDRESS1;
+      case  2: return PwmRegister::ADDRESS2;
+      case  3: return PwmRegister::ADDRESS3;
+      case  4: return PwmRegister::ADDRESS4;
+      case  5: return PwmRegister::ADDRESS5;
+      #endif // DRIVER_PWM_DMA
+      default: return 0;
+    }
+  }
+  
+  /** 
+   * Returns the trip interrupt source of the module.
+   *
+   * @return the EPWMx_TZINT interrupt source.
+   */    
+  int32 getTripSource() const
+  {
+    // The interrupts are in the PIE group 2
+    return index_ << 4 | 0x0001;
+  }
+  
+  /** 
+   * Writes a SOC trigger settings.
+   *
+   * @param soc    a SOC trigger index.
+   * @param bit    a selected event bits.
+   * @param period a number of events from 1 to 3 for generating a SOC trigger.
+   * @param enable enable the trigger.
+   */    
+  void writeSoc(int32 soc, uint16 bit, int32 period, bool enable)
+  {
+    uint16 en = enable ? 1 : 0;
+    if(soc == 0)
+    {
+      regPwm_->etsel.bit.socasel = bit;
+      regPwm_->etps.bit.socaprd = period;
+      regPwm_->etsel.bit.socaen = en;
+    }
+    else
+    {
+      regPwm_->etsel.bit.socbsel = bit;
+      regPwm_->etps.bit.socbprd = period;
+      regPwm_->etsel.bit.socben = en;
+    }
+  }
+  
+  /** 
+   * Resets a SOC trigger and its software prescaler.
+   *
+   * @param soc a SOC trigger index.
+   */    
+  void resetSoc(int32 soc)
+  {
+    if(soc == 0)
+    {
+      regPwm_->etsel.bit.socaen = 0;
+      regPwm_->etsel.bit.socasel = 0;
+    }
+    else
+    {
+      regPwm_->etsel.bit.socben = 0;
+      regPwm_->etsel.bit.socbsel = 0;
+    }
+    if(prescaler_[soc].period == 0) return;
+    prescaler_[soc].period = 0;
+    // Release the interrupt if no one uses it
+    if(eventTask_ == NULL && !isPrescaled() && !isBursting()) closeInterrupt();
+  }
+  
+  /** 
+   * Tests if a SOC trigger is prescaled by software.
+   *
+   * @return true if the interrupt service routine prescales a SOC trigger.
+   */    
+  bool isPrescaled() const
+  {
+    for(int32 i=0; i<SOC_NUMBER; i++) 
+    {
+      if(prescaler_[i].period != 0) return true;
+    }
+    return false;
+  }
+  
+  /** 
+   * Tests if the PWM interrupt might be generated with given settings.
+   *
+   * @param bit    a selected event bits.
+   * @param period a number of events from 1 to 3 for generating an interrupt.
+   * @return true if the settings do not conflict with the used interrupt.
+   */    
+  bool isInterrupt(uint16 bit, int32 period) const
+  {
+    // The software prescaler and the burst counter need the interrupt on each their event
+    if(!isPrescaled() && !isBursting()) return true;
+    if(regPwm_->etsel.bit.intsel != bit) return false;
+    if(regPwm_->etps.bit.intprd != period) return false;
+    return true;
+  }
+  
+  /** 
+   * Opens the PWM interrupt.
+   *
+   * @param bit    a selected event bits.
+   * @param period a number of events from 1 to 3 for generating an interrupt.
+   * @return true if the interrupt has been opened.
+   */    
+  bool openInterrupt(uint16 bit, int32 period)
+  {
+    if(eventInt_ == NULL) 
+    {
+      eventInt_ = Interrupt::create(*this, getEventSource());
+      if(eventInt_ == NULL) return false;
+    }
+    bool is = eventInt_->disable();
+    // The settings are not changed if the interrupt is generating with them
+    if(is && regPwm_->etsel.bit.inten == 1 && regPwm_->etsel.bit.intsel == bit && regPwm_->etps.bit.intprd == period) 
+    {
+      eventInt_->enable(true);
+      return true;
+    }
+    regPwm_->etsel.bit.inten = 0;
+    regPwm_->etsel.bit.intsel = bit;
+    regPwm_->etps.bit.intprd = period;
+    // Clear an interrupt flag which might be set before, as no interrupt is generated while it is set
+    regPwm_->etclr.val = 0x0001;
+    regPwm_->etsel.bit.inten = 1;
+    eventInt_->enable(true);
+    return true;
+  }
+  
+  /** 
+   * Closes the PWM interrupt.
+   */    
+  void closeInterrupt()
+  {
+    regPwm_->etsel.bit.inten = 0;
+    regPwm_->etsel.bit.intsel = 0;
+    regPwm_->etps.bit.intprd = 0;
+    if(eventInt_ != NULL) 
+    {
+      eventInt_->disable();
+      delete eventInt_;
+    }
+    eventInt_ = NULL;
+  }
+  
+  /** 
+   * Gates the SOC triggers prescaled by software.
+   *
+   * The method is called from the PWM interrupt service routine on each event. 
+   * A SOC trigger is enabled after the event before the last event of its period,
+   * and it is disabled after the last event when the SOC has been generated.
+   */    
+  void prescale()
+  {
+    for(int32 i=0; i<SOC_NUMBER; i++)
+    {
+      Prescaler& pre = prescaler_[i];
+      if(pre.period == 0) continue;
+      uint16 en;
+      if(++pre.count < pre.period - 1) continue;
+      if(pre.count == pre.period - 1)
+      {
+        en = 1;
+      }
+      else
+      {
+        en = 0;
+        pre.count = 0;
+      }
+      if(i == 0)
+        regPwm_->etsel.bit.socaen = en;
+      else
+        regPwm_->etsel.bit.socben = en;
+    }
+  }
+  
+  /** 
+   * Counts the burst pulses.
+   *
+   * The method is called from the PWM interrupt service routine on each boundary event. 
+   * The outputs force is written during the last pulse, and the hardware loads it
+   * on the boundary event after the pulse.
+   */    
+  void countBurst()
+  {
+    if(burst_.pulses == 0) return;
+    int32 count = ++burst_.count;
+    if(count == burst_.pulses) 
+    {
+      regPwm_->aqcsfrc.val = BURST_FORCE;
+    }
+    else if(count > burst_.pulses)
+    {
+      regPwm_->aqsfrc.bit.rldcsf = Aqsfrc::LOAD_IMMEDIATE;
+      burst_.pulses = 0;
+      // The interrupt is kept for the user handler or the software prescaler
+      if(eventTask_ == NULL && !isPrescaled()) regPwm_->etsel.bit.inten = 0;
+    }
+  }
+  
+  /** 
+   * Cancels a burst of the stopped module.
+   *
+   * The outputs are forced low immediately as they are forced after a completed burst.
+   */    
+  void cancelBurst()
+  {
+    if(!isBursting()) return;
+    bool is = Interrupt::globalDisable();
+    regPwm_->aqsfrc.bit.rldcsf = Aqsfrc::LOAD_IMMEDIATE;
+    regPwm_->aqcsfrc.val = BURST_FORCE;
+    burst_.pulses = 0;
+    burst_.count = 0;
+    Interrupt::globalEnable(is);
+    // The interrupt is kept for the user handler or the software prescaler
+    if(eventTask_ == NULL && !isPrescaled()) closeInterrupt();
+  }
+  
+  /** 
+   * Returns the PWM interrupt source of the module.
+   *
+   * @return the EPWMx_INT interrupt source.
+   */    
+  int32 getEventSource() const
+  {
+    // The interrupts are in the PIE group 3
+    return index_ << 4 | 0x0002;
+  }
+  
+  /** 
+   * Returns the trip bits of the TZFLG, TZCLR and TZFRC registers.
+   *
+   * @param mode a trip mode.
+   * @return the register bits.
+   */    
+  static uint16 getTripBits(TripMode mode)
+  {
+    return mode == Pwm::TRIP_CBC ? 0x0002 : 0x0004;
+  }
+  
+  /** 
+   * Configures a GPIO pin as a trip zone input.
+   *
+   * @param zone a trip zone number from 1 to 6.
+   * @return true if the pin has been configured.
+   */    
+  bool setTripPin(int32 zone)
+  {
+    if(!mutex_.drv.lock()) return false;
+    bool res = true;
+    System::eallow();
+    switch(zone)
+    {
+      // Enable the pullup, asynchronous input, and TZ1-TZ4 pins function
+      case  1: regGpio_->gpapud.bit.gpio12 = 0; regGpio_->gpaqsel1.bit.gpio12 = 3; regGpio_->gpamux1.bit.gpio12 = 1; break;
+      case  2: regGpio_->gpapud.bit.gpio13 = 0; regGpio_->gpaqsel1.bit.gpio13 = 3; regGpio_->gpamux1.bit.gpio13 = 1; break;
+      case  3: regGpio_->gpapud.bit.gpio14 = 0; regGpio_->gpaqsel1.bit.gpio14 = 3; regGpio_->gpamux1.bit.gpio14 = 1; break;
+      case  4: regGpio_->gpapud.bit.gpio15 = 0; regGpio_->gpaqsel1.bit.gpio15 = 3; regGpio_->gpamux1.bit.gpio15 = 1; break;
+      // Enable the pullup, asynchronous input, and TZ5-TZ6 pins function
+      case  5: regGpio_->gpapud.bit.gpio16 = 0; regGpio_->gpaqsel2.bit.gpio16 = 3; regGpio_->gpamux2.bit.gpio16 = 3; break;
+      case  6: regGpio_->gpapud.bit.gpio17 = 0; regGpio_->gpaqsel2.bit.gpio17 = 3; regGpio_->gpamux2.bit.gpio17 = 3; break;
+      default: res = false;
+    }
+    System::dallow();
+    return mutex_.drv.unlock(res);
+  }
+  
   /** 
    * Turns the PWM clock on.
    */    
@@ -1330,6 +2993,40 @@ private:
     return (f.val - 1.0f) * LOG2E + exp;
   }
   
+  /**
+   * Resets the high resolution calibration state.
+   */
+  static void resetCalibration()
+  {
+    cursor_ = 0;
+    steps_ = 0;
+    drift_ = 0;
+    calibrated_ = 0;
+    calibration_.passes = 0;
+    calibration_.steps = 0;
+    calibration_.drift = 0;
+    calibration_.maxDrift = 0;
+    calibration_.errors = 0;
+    for(int32 i=0; i<Calibration::MODULES; i++) calibration_.mep[i] = 0;
+  }
+
+  /**
+   * Moves the high resolution calibration to the next module.
+   */
+  static void nextCalibration()
+  {
+    if(++cursor_ < RESOURCES_NUMBER) return;
+    cursor_ = 0;
+    // The pass is completed if at least one module has been calibrated
+    if(calibrated_ == 0) return;
+    calibration_.passes++;
+    calibration_.steps = steps_;
+    calibration_.drift = drift_;
+    steps_ = 0;
+    drift_ = 0;
+    calibrated_ = 0;
+  }
+  
   /**
    * Copy constructor.
    *
@@ -1345,6 +3042,156 @@ private:
    */
   PwmController& operator =(const PwmController& obj);    
   
+protected:
+
+  /**
+   * Duty to compare value scaling of the started task.
+   *
+   * A compare value is calculated as base + sign * (scale * duty >> 15),
+   * where the sign is applied by XOR with 0 or -1 mask.
+   */
+  struct Compare
+  {
+    /** 
+     * Constructor.
+     */    
+    Compare() :
+      base  (0),
+      scale (0),
+      sign  (0){
+    }
+    
+    /** 
+     * Destructor.
+     */    
+   ~Compare(){}
+   
+    /**
+     * Compare value of zero duty.
+     */  
+    int32 base;
+    
+    /**
+     * Count of time-base clocks of full duty.
+     */  
+    uint32 scale;
+
+    /**
+     * Inverse mask, which is 0 for direct and -1 for inverse compare.
+     */      
+    int32 sign;
+
+  };
+
+  /**
+   * Time conversion factors of a clock.
+   *
+   * The factors are reciprocals in fixed-point formats, which
+   * let the driver convert times and clocks by multiplying only.
+   */
+  struct Time
+  {
+    /** 
+     * Constructor.
+     */    
+    Time() :
+      clocks (0),
+      ns     (0){
+    }
+    
+    /** 
+     * Destructor.
+     */    
+   ~Time(){}
+
+    /** 
+     * Calculates the factors.
+     *
+     * @param clock  a clock in Hz.
+     * @param cycles a number of the clock cycles in one unit.
+     */    
+    void set(int32 clock, int32 cycles)
+    {
+      if(clock <= 0 || cycles <= 0) return;
+      uint64 ns = static_cast<uint64>(cycles) * 1000000000;
+      clocks = static_cast<uint32>( ( (static_cast<uint64>(clock) << 32) + ns / 2 ) / ns );
+      this->ns = static_cast<uint32>( ( (ns << 16) + clock / 2 ) / static_cast<uint64>(clock) );
+    }
+   
+    /**
+     * Units per one ns in Q32 format.
+     */  
+    uint32 clocks;
+    
+    /**
+     * Time of one unit in ns in Q16 format.
+     */  
+    uint32 ns;
+
+  };
+
+private:
+  
+  /**
+   * The software prescaler of a SOC trigger.
+   */
+  struct Prescaler
+  {
+    /** 
+     * Constructor.
+     */    
+    Prescaler() :
+      period (0),
+      count  (0){
+    }
+
+    /** 
+     * Destructor.
+     */    
+   ~Prescaler(){}
+  
+    /**
+     * Number of events for generating a SOC trigger, or zero if the prescaler is not used.
+     */  
+    int32 period;
+
+    /**
+     * Number of occurred events.
+     */      
+    int32 count;
+
+  };    
+  
+  /**
+   * The burst counter.
+   */
+  struct Burst
+  {
+    /** 
+     * Constructor.
+     */    
+    Burst() :
+      pulses (0),
+      count  (0){
+    }
+
+    /** 
+     * Destructor.
+     */    
+   ~Burst(){}
+  
+    /**
+     * Number of pulses of the burst, or zero if no burst is generated.
+     */  
+    int32 pulses;
+
+    /**
+     * Number of occurred boundary events.
+     */      
+    int32 count;
+
+  };    
+  
   /**
    * Mutexs of the driver and the resource.
    */
@@ -1574,6 +3421,51 @@ protected:
    */
   static const int32 DEAD_BAND_KEYS_NUMBER = 6;
   
+  /**
+   * Max number of events for generating the PWM interrupt and SOC triggers by the hardware.
+   */
+  static const int32 EVENT_PERIOD_MAX = 3;
+  
+  /**
+   * Max number of pulses of a burst.
+   */
+  static const int32 BURST_PULSES_MAX = 0xffff;
+  
+  /**
+   * The TBCTL register PHSEN, SYNCOSEL and PHSDIR bits kept by profiles.
+   */
+  static const uint16 PROFILE_TBCTL_MASK = 0x2034;
+  
+  /**
+   * The ETSEL and ETPS registers SOC bits kept by profiles.
+   */
+  static const uint16 PROFILE_SOC_MASK = 0xff00;
+  
+  /**
+   * The AQCSFRC register value for forcing both outputs low.
+   */
+  static const uint16 BURST_FORCE = 0x0005;
+  
+  /**
+   * Number of SOC triggers.
+   */
+  static const int32 SOC_NUMBER = 2;
+  
+  /**
+   * SYSCLKOUT clocks of testing the load window and writing one module.
+   */
+  static const int32 WRITING_CYCLES = 96;
+  
+  /**
+   * Max divider of the time-base clock.
+   */
+  static const int32 CLOCK_DIVIDER_MAX = 128 * 14;
+  
+  /**
+   * Number of trip zones.
+   */
+  static const int32 TRIP_ZONES_NUMBER = 6;
+  
   /**
    * PWM chopper enable key index.
    */
@@ -1638,6 +3530,16 @@ protected:
    */  
   static GpioRegister* regGpio_;
 
+  /**
+   * DMA Registers (no boot).
+   */  
+  static DmaRegister* regDma_;
+
+  /**
+   * Locked DMA channels of the modules (no boot).
+   */  
+  static bool dmaLock_[RESOURCES_NUMBER];
+
   /**
    * Mutex of this driver (no boot).
    */  
@@ -1647,6 +3549,41 @@ protected:
    * Driver has been initialized successfully (no boot).
    */
   static int32 isInitialized_;
+
+  /**
+   * Constructed PWM modules (no boot).
+   */
+  static PwmController* controller_[RESOURCES_NUMBER];
+
+  /**
+   * Time conversion factors of the chopper one-shot pulse width unit (no boot).
+   */
+  static Time pulse_;
+
+  /**
+   * The high resolution calibration report (no boot).
+   */
+  static Calibration calibration_;
+
+  /**
+   * Index of the calibrating module (no boot).
+   */
+  static int32 cursor_;
+
+  /**
+   * Calibration steps of the current pass (no boot).
+   */
+  static int32 steps_;
+
+  /**
+   * Max MEP Scale Factor change of the current pass (no boot).
+   */
+  static int32 drift_;
+
+  /**
+   * Calibrated modules of the current pass (no boot).
+   */
+  static int32 calibrated_;
   
   #ifdef DRIVER_HRPWM
   
@@ -1654,6 +3591,11 @@ protected:
    * HR PWM enabled.
    */
   bool isHiRes_;  
+
+  /**
+   * HR PWM controls the phase.
+   */
+  bool isHiResPhase_;
   
   #endif // DRIVER_HRPWM
   
@@ -1670,7 +3612,7 @@ protected:
   /**
    * The current executing task.
    */  
-  Task<CHANNELS_NUMBER> task_;
+  ::Pwm::Task<CHANNELS_NUMBER> task_;
 
   /**
    * The index of ePWM module.
@@ -1682,6 +3624,11 @@ protected:
    */
   int32 tbclk_;
   
+  /**
+   * The time-base clock is selected for each task frequency.
+   */
+  bool isAutoClock_;
+  
   /**
    * Dead-band values.
    */  
@@ -1692,6 +3639,51 @@ protected:
    */  
   ::PwmController::Chopper chopper_;    
   
+  /**
+   * Duty to compare value scaling.
+   */  
+  ::PwmController::Compare compare_;  
+
+  /**
+   * Time conversion factors of the time-base clock.
+   */  
+  ::PwmController::Time time_;  
+
+  /**
+   * Delay of the channel A high resolution edge in time-base clocks in Q16 format.
+   */  
+  uint32 delay_;
+  
+  /**
+   * The trip interrupt.
+   */  
+  ::Interrupt* tripInt_;
+  
+  /**
+   * The trip interrupt user handler.
+   */  
+  ::InterruptTask* tripTask_;
+  
+  /**
+   * The PWM interrupt.
+   */  
+  ::Interrupt* eventInt_;
+  
+  /**
+   * The PWM interrupt user handler.
+   */  
+  ::InterruptTask* eventTask_;
+  
+  /**
+   * The software prescalers of SOC triggers.
+   */  
+  ::PwmController::Prescaler prescaler_[SOC_NUMBER];
+  
+  /**
+   * The burst counter which is changed in the interrupt service routine.
+   */  
+  volatile ::PwmController::Burst burst_;
+  
   /**
    * Submodule keys.
    *
@@ -1723,6 +3715,16 @@ SystemRegister* PwmController::regSys_;
  */  
 GpioRegister* PwmController::regGpio_;
 
+/**
+ * DMA Registers (no boot).
+ */  
+DmaRegister* PwmController::regDma_;
+
+/**
+ * Locked DMA channels of the modules (no boot).
+ */  
+bool PwmController::dmaLock_[PwmController::RESOURCES_NUMBER];
+
 /**
  * Mutex of this driver (no boot).
  */  
@@ -1733,4 +3735,39 @@ Mutex* PwmController::drvMutex_;
  */
 int32 PwmController::isInitialized_;
 
+/**
+ * Constructed PWM modules (no boot).
+ */
+PwmController* PwmController::controller_[PwmController::RESOURCES_NUMBER];
+
+/**
+ * Time conversion factors of the chopper one-shot pulse width unit (no boot).
+ */
+PwmController::Time PwmController::pulse_;
+
+/**
+ * The high resolution calibration report (no boot).
+ */
+Pwm::Calibration PwmController::calibration_;
+
+/**
+ * Index of the calibrating module (no boot).
+ */
+int32 PwmController::cursor_;
+
+/**
+ * Calibration steps of the current pass (no boot).
+ */
+int32 PwmController::steps_;
+
+/**
+ * Max MEP Scale Factor change of the current pass (no boot).
+ */
+int32 PwmController::drift_;
+
+/**
+ * Calibrated modules of the current pass (no boot).
+ */
+int32 PwmController::calibrated_;
+
 #endif // DRIVER_PWM_CONTROLLER_HPP_
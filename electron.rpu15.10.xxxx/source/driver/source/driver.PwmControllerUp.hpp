@@ -38,42 +38,6 @@ public:
   {
   }
   
-  /**
-   * Starts generating the tasked wave of the PWM module.
-   *
-   * @return true if the task has been started successfully.
-   */
-  virtual bool start()
-  {
-    if(!isConstructed()) return false;
-    if(!mutex_.res.lock()) return false;    
-    if(!isTask(task_)) return mutex_.res.unlock( false );
-    uint16 prd, cmp[CHANNELS_NUMBER];
-    // Set timer period
-    int32 pwmclk = task_.getFrequency();
-    // Rounding up real count of timer-base clocks which wishes to be loaded
-    uint32 count = tbclk_ / pwmclk + (tbclk_ % pwmclk != 0 ? 1 : 0);
-    // Real count of timer-base clocks which will be loaded
-    prd = (count - 1) & 0x0000ffff;
-    for(int32 i=0; i<CHANNELS_NUMBER; i++)
-    {
-      float32 duty = task_.getDuty(i);
-      if(duty == ERROR) duty = 0.0f;
-      float32 value = static_cast<float32>(count) * duty / 100.0f - 1.0f;    
-      cmp[i] = static_cast<uint32>(value) & 0x0000ffff;
-    }
-    // Write values to the registers in iterrupts disable mode
-    // for possibility to call the method in an interrupt handler
-    bool is = disable();
-    regPwm_->tbprd.val = prd;
-    for(int32 i=0; i<CHANNELS_NUMBER; i++) regPwm_->cmp[i].val = cmp[i];    
-    enable(is);
-    #ifdef DRIVER_HRPWM
-    startHighResolution();
-    #endif // DRIVER_HRPWM        
-    return mutex_.res.unlock( true );
-  }
-  
   /**
    * Returns the PWM signal frequency of currently assigned task.
    *
@@ -96,6 +60,19 @@ public:
     }
     return mutex_.res.unlock(freq);
   }
+
+  /**
+   * Returns the PWM signal period.
+   *
+   * @return the period in the time-base clocks, or ERROR if error has been occurred.
+   */    
+  virtual int32 getSignalPeriod() const
+  {
+    if(!isConstructed()) return ERROR;
+    if(!mutex_.res.lock()) return ERROR;
+    int32 prd = regPwm_->tbprd.val;
+    return mutex_.res.unlock(prd + 1);
+  }
   
   /**
    * Returns the PWM module channel duty of currently assigned task.
@@ -134,35 +111,6 @@ public:
     return Pwm::UP;
   }
   
-  #ifdef DRIVER_HRPWM  
-  
-  /**
-   * Enables the PWM channels in high resolution mode.
-   *
-   * @return true if high resolution mode is set successfully.
-   */        
-  virtual bool enableHighResolution()
-  {
-    if(!isConstructed()) return false;
-    // TI highly recommends that TBCLK=SYSCLKOUT
-    if(tbclk_ != sysclk_) return false;
-    // TI says that min SYSCLKOUT must be 60 MHz
-    if(sysclk_ < 60000000) return false;
-    if(!mutex_.res.lock()) return false;
-    System::eallow();    
-    // Set CMPAHR to controls the micro edge position
-    regPwm_->hrcnfg.bit.ctlmode = 0x0;
-    // Control falling edge position
-    regPwm_->hrcnfg.bit.edgmode = 0x2;
-    // Set CMPAHR is loaded when CTR equals to zero and match the CMPA selection
-    regPwm_->hrcnfg.bit.hrload = 0x0;
-    System::dallow();    
-    isHiRes_ = true;
-    return mutex_.res.unlock(true);
-  }
-  
-  #endif // DRIVER_HRPWM          
-  
 protected:
   
   /**
@@ -173,7 +121,7 @@ protected:
   virtual int32 maxFrequency() const
   {
     if(!isConstructed()) return ERROR;
-    return tbclk_;
+    return getMaxClock();
   }
   
   /**
@@ -184,7 +132,83 @@ protected:
   virtual int32 minFrequency() const
   {
     if(!isConstructed()) return ERROR;        
-    return tbclk_ / 0xffff + 1;
+    return getMinClock() / 0xffff + 1;
+  }
+  
+  /**
+   * Calculates the period and compare values of a task.
+   *
+   * @param task  a correct task.
+   * @param image a register image.
+   */
+  virtual void compileTask(const TaskInterface& task, Image& image) const
+  {
+    // Rounding up real count of timer-base clocks which wishes to be loaded
+    uint32 count = getTaskCount(task, image.clock);
+    // Real count of timer-base clocks which will be loaded
+    image.tbprd = (count - 1) & 0x0000ffff;
+    for(int32 i=0; i<CHANNELS_NUMBER; i++)
+    {
+      float32 duty = task.getDuty(i);
+      if(duty == ERROR) duty = 0.0f;
+      float32 value = static_cast<float32>(count) * duty / 100.0f - 1.0f;    
+      image.cmp[i] = static_cast<uint32>(value) & 0x0000ffff;
+      // The MEP delays the falling edge by the fractional part of the compare value
+      if(i == 0 && value > 0.0f) image.delay = getDelay( value - static_cast<float32>( static_cast<int32>(value) ) );
+    }
+    // Set scaling of the fast duty updating
+    image.base = -1;
+    image.scale = count;
+    image.sign = 0;
+  }
+  
+  /**
+   * Returns the high resolution edge mode of the counting policy.
+   *
+   * @return the HRCNFG register EDGMODE bits.
+   */  
+  virtual int32 getEdgeMode() const
+  {
+    // Control falling edge position
+    return 0x2;
+  }
+  
+  /**
+   * Returns the default action-qualifier control of a channel.
+   *
+   * @param channel a channel number.
+   * @return the AQCTL register value.
+   */  
+  virtual uint16 getQualifiers(int32 channel) const
+  {
+    ::PwmRegister::Aqctl aqctl = 0x0000;
+    switch(channel)
+    {
+      case 0:
+      {
+        aqctl.bit.zro = Aqctl::SET;
+        aqctl.bit.cau = Aqctl::CLEAR;
+      }
+      break;
+      case 1:
+      {
+        aqctl.bit.zro = Aqctl::SET;
+        aqctl.bit.cbu = Aqctl::CLEAR;
+      }
+      break;
+      default: break;
+    }
+    return aqctl.val;
+  }
+  
+  /**
+   * Returns the period boundary event where the outputs are low.
+   *
+   * @return the CTR_ZERO or CTR_PRD event.
+   */  
+  virtual int32 getBoundaryEvent() const
+  {
+    return CTR_PRD;
   }
   
   /**
@@ -226,26 +250,7 @@ private:
     regSys_->pclkcr0.bit.tbclksync = 0;
     // Set UP counting mode
     regPwm_->tbctl.bit.ctrmode = Tbctl::COUNT_UP;    
-    for(int32 i=0; i<CHANNELS_NUMBER; i++)
-    {
-      regPwm_->aqctl[i].val = 0x0000;    
-      switch(i)
-      {
-        case 0:
-        {
-          regPwm_->aqctl[i].bit.zro = Aqctl::SET;
-          regPwm_->aqctl[i].bit.cau = Aqctl::CLEAR;
-        }
-        break;
-        case 1:
-        {
-          regPwm_->aqctl[i].bit.zro = Aqctl::SET;
-          regPwm_->aqctl[i].bit.cbu = Aqctl::CLEAR;
-        }
-        break;
-        default: break;
-      }
-    }
+    for(int32 i=0; i<CHANNELS_NUMBER; i++) regPwm_->aqctl[i].val = getQualifiers(i);
     regSys_->pclkcr0.bit.tbclksync = 1;
     System::dallow();    
     return true;
@@ -38,40 +38,6 @@ public:
   {
   }
   
-  /**
-   * Starts generating the tasked wave of the PWM module.
-   *
-   * @return true if the task has been started successfully.
-   */
-  virtual bool start()
-  {
-    if(!isConstructed()) return false;
-    if(!mutex_.res.lock()) return false;    
-    if(!isTask(task_)) return mutex_.res.unlock( false );  
-    uint16 prd, cmp[CHANNELS_NUMBER];
-    // Set timer period
-    int32 pwmclk = task_.getFrequency();
-    // Rounding up real count of timer-base clocks which wishes to be loaded
-    uint32 count = tbclk_ / pwmclk + (tbclk_ % pwmclk != 0 ? 1 : 0);
-    // Real count of timer-base clocks which will be loaded
-    prd = (count / 2) & 0x0000ffff;
-    for(int32 i=0; i<CHANNELS_NUMBER; i++)
-    {
-      float32 duty = task_.getDuty(i);
-      if(duty == ERROR) duty = 0.0f;
-      float32 dead = 100.0f - duty;
-      float32 value = static_cast<float32>(prd) * dead / 100.0f + 0.5f;
-      cmp[i] = static_cast<uint32>(value) & 0x0000ffff;
-    }
-    // Write values to the registers in iterrupts disable mode
-    // for possibility to call the method in an interrupt handler
-    bool is = disable();
-    regPwm_->tbprd.val = prd;
-    for(int32 i=0; i<CHANNELS_NUMBER; i++) regPwm_->cmp[i].val = cmp[i];    
-    enable(is);
-    return mutex_.res.unlock( true );
-  }
-
   /**
    * Returns the PWM signal frequency of currently assigned task.
    *
@@ -94,6 +60,19 @@ public:
     }
     return mutex_.res.unlock(freq);
   }
+
+  /**
+   * Returns the PWM signal period.
+   *
+   * @return the period in the time-base clocks, or ERROR if error has been occurred.
+   */    
+  virtual int32 getSignalPeriod() const
+  {
+    if(!isConstructed()) return ERROR;
+    if(!mutex_.res.lock()) return ERROR;
+    int32 prd = regPwm_->tbprd.val;
+    return mutex_.res.unlock(2 * prd);
+  }
   
   /**
    * Returns the PWM module channel duty of currently assigned task.
@@ -142,7 +121,7 @@ protected:
   virtual int32 maxFrequency() const
   {
     if(!isConstructed()) return ERROR;
-    return tbclk_ / 2;
+    return getMaxClock() / 2;
   }
   
   /**
@@ -153,7 +132,92 @@ protected:
   virtual int32 minFrequency() const
   {
     if(!isConstructed()) return ERROR;        
-    return tbclk_ / 0xffff / 2 + 1;
+    return getMinClock() / 0xffff / 2 + 1;
+  }
+  
+  /**
+   * Calculates the period and compare values of a task.
+   *
+   * @param task  a correct task.
+   * @param image a register image.
+   */
+  virtual void compileTask(const TaskInterface& task, Image& image) const
+  {
+    // Rounding up real count of timer-base clocks which wishes to be loaded
+    uint32 count = getTaskCount(task, image.clock);
+    // Real count of timer-base clocks which will be loaded
+    uint16 prd = (count / 2) & 0x0000ffff;
+    image.tbprd = prd;
+    for(int32 i=0; i<CHANNELS_NUMBER; i++)
+    {
+      float32 duty = task.getDuty(i);
+      if(duty == ERROR) duty = 0.0f;
+      float32 dead = 100.0f - duty;
+      float32 value = static_cast<float32>(prd) * dead / 100.0f + 0.5f;
+      if(i == 0 && isHiResDuty())
+      {
+        // The pulse is changed by two clocks in the registers, thus the half of pulse
+        // is rounded down, and the MEP delays the falling edge by the rest up to two clocks
+        float32 half = static_cast<float32>(prd) * duty / 100.0f;
+        uint32 count = static_cast<uint32>(half);
+        value = static_cast<float32>(prd - count);
+        image.delay = getDelay( 2.0f * (half - static_cast<float32>(count)) );
+      }
+      image.cmp[i] = static_cast<uint32>(value) & 0x0000ffff;
+    }
+    // Set scaling of the fast duty updating
+    image.base = prd;
+    image.scale = prd;
+    image.sign = -1;
+  }
+  
+  /**
+   * Returns the high resolution edge mode of the counting policy.
+   *
+   * @return the HRCNFG register EDGMODE bits.
+   */  
+  virtual int32 getEdgeMode() const
+  {
+    // Control falling edge position, which is on the counting down
+    return 0x2;
+  }
+  
+  /**
+   * Returns the default action-qualifier control of a channel.
+   *
+   * @param channel a channel number.
+   * @return the AQCTL register value.
+   */  
+  virtual uint16 getQualifiers(int32 channel) const
+  {
+    ::PwmRegister::Aqctl aqctl = 0x0000;
+    switch(channel)
+    {
+      case 0:
+      {
+        aqctl.bit.cau = Aqctl::SET;
+        aqctl.bit.cad = Aqctl::CLEAR;
+      }
+      break;
+      case 1:
+      {
+        aqctl.bit.cbu = Aqctl::SET;
+        aqctl.bit.cbd = Aqctl::CLEAR;
+      }
+      break;
+      default: break;
+    }
+    return aqctl.val;
+  }
+  
+  /**
+   * Returns the period boundary event where the outputs are low.
+   *
+   * @return the CTR_ZERO or CTR_PRD event.
+   */  
+  virtual int32 getBoundaryEvent() const
+  {
+    return CTR_ZERO;
   }
   
   /**
@@ -199,26 +263,7 @@ private:
     regSys_->pclkcr0.bit.tbclksync = 0;
     // Set UPDOWN counting mode
     regPwm_->tbctl.bit.ctrmode = Tbctl::COUNT_UPDOWN;    
-    for(int32 i=0; i<CHANNELS_NUMBER; i++)
-    {
-      regPwm_->aqctl[i].val = 0x0000;    
-      switch(i)
-      {
-        case 0:
-        {
-          regPwm_->aqctl[i].bit.cau = Aqctl::SET;
-          regPwm_->aqctl[i].bit.cad = Aqctl::CLEAR;
-        }
-        break;
-        case 1:
-        {
-          regPwm_->aqctl[i].bit.cbu = Aqctl::SET;
-          regPwm_->aqctl[i].bit.cbd = Aqctl::CLEAR;
-        }
-        break;
-        default: break;
-      }
-    }
+    for(int32 i=0; i<CHANNELS_NUMBER; i++) regPwm_->aqctl[i].val = getQualifiers(i);
     regSys_->pclkcr0.bit.tbclksync = 1;
     System::dallow();    
     return true;
@@ -0,0 +1,272 @@
+/**
+ * TI TMS320F2833x DSP Enhanced Pulse Width Modulator spread-spectrum dither controller.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_PWM_DITHER_CONTROLLER_HPP_
+#define DRIVER_PWM_DITHER_CONTROLLER_HPP_
+
+#include "driver.Object.hpp"
+#include "driver.InterruptTask.hpp"
+#include "driver.PwmController.hpp"
+#include "driver.PwmDitherSequence.hpp"
+
+class PwmDitherController : public ::Object, public ::Pwm::Dither, public ::InterruptTask
+{
+  typedef ::Object  Parent;
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param pwm      a PWM module created by the driver.
+   * @param capacity max number of PWM periods in the sequence.
+   */
+  PwmDitherController(::Pwm& pwm, int32 capacity) : Parent(), ::InterruptTask(),
+    // All PWM interfaces created by the driver are the PWM controllers
+    pwm_         (static_cast< ::PwmController& >(pwm)),
+    capacity_    (capacity),
+    length_      (0),
+    index_       (0),
+    isDithering_ (false),
+    table_       (NULL){
+    for(int32 i=0; i<ENTRY_SIZE; i++) nominal_[i] = 0;
+    setConstruct( construct() );
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~PwmDitherController()
+  {
+    stop();
+    if(table_ != NULL) delete[] table_;
+  }
+
+  /**
+   * Starts the dither.
+   *
+   * @param band     max deviation of the period in percentages of the task period.
+   * @param length   a number of PWM periods in the sequence from 2 to the capacity.
+   * @param sequence a sequence of the periods.
+   * @return true if the dither has been started successfully.
+   */
+  virtual bool start(float32 band, int32 length, Sequence sequence=TRIANGLE)
+  {
+    if(!isConstructed()) return false;
+    if(band <= 0.0f || band >= 100.0f) return false;
+    if(length < LENGTH_MIN || length > capacity_) return false;
+    if(sequence != TRIANGLE && sequence != RANDOM) return false;
+    stop();
+    // The nominal values are written in the load window when the dither is stopped
+    if(!pwm_.isWindow()) return false;
+    if(!compute(band, length, sequence)) return false;
+    length_ = length;
+    index_ = 0;
+    isDithering_ = true;
+    // The entries are written after the counter-equal-zero event loads the previous ones
+    if(!pwm_.getTrigger().setInterrupt(*this, ::Pwm::CTR_ZERO, 1))
+    {
+      isDithering_ = false;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Stops the dither.
+   */
+  virtual void stop()
+  {
+    if(!isConstructed()) return;
+    bool is = Interrupt::globalDisable();
+    bool isDithering = isDithering_;
+    isDithering_ = false;
+    Interrupt::globalEnable(is);
+    if(!isDithering) return;
+    pwm_.getTrigger().resetInterrupt();
+    is = Interrupt::globalDisable();
+    // The nominal values are written anyway, as the window exists for a started dither
+    pwm_.waitWindow();
+    write(nominal_);
+    Interrupt::globalEnable(is);
+  }
+
+  /**
+   * Tests if the dither is started.
+   *
+   * @return true if the dither is started.
+   */
+  virtual bool isDithering() const
+  {
+    return isDithering_;
+  }
+
+  /**
+   * Writes next table entry.
+   *
+   * The method is called by the interrupt of the PWM module.
+   */
+  virtual void handler()
+  {
+    if(!isDithering_) return;
+    int32 index = index_;
+    write(&table_[ENTRY_SIZE * index]);
+    index_ = ++index < length_ ? index : 0;
+  }
+
+  /**
+   * Tests if this object has been constructed.
+   *
+   * @return true if object has been constructed successfully.
+   */
+  virtual bool isConstructed() const
+  {
+    return this->Parent::isConstructed();
+  }
+
+private:
+
+  /**
+   * Number of the table entry words, which are the period and compare values of channels.
+   */
+  static const int32 ENTRY_SIZE = 1 + ::PwmController::CHANNELS_NUMBER;
+
+  /**
+   * Min number of PWM periods in the sequence.
+   */
+  static const int32 LENGTH_MIN = 2;
+
+  /**
+   * Max number of PWM periods in the sequence.
+   */
+  static const int32 CAPACITY_MAX = 0x2000;
+
+  /**
+   * Min count of time-base clocks of a dithered period.
+   */
+  static const int32 SCALE_MIN = 2;
+
+  /**
+   * Constructor.
+   *
+   * @return boolean result.
+   */
+  bool construct()
+  {
+    if(!Parent::isConstructed()) return false;
+    if(!pwm_.isConstructed()) return false;
+    if(capacity_ < LENGTH_MIN || capacity_ > CAPACITY_MAX) return false;
+    table_ = new uint16[capacity_ * ENTRY_SIZE];
+    return table_ != NULL;
+  }
+
+  /**
+   * Computes the table of the sequence.
+   *
+   * @param band     max deviation of the period in percentages of the task period.
+   * @param length   a number of PWM periods in the sequence.
+   * @param sequence a sequence of the periods.
+   * @return true if the table has been computed successfully.
+   */
+  bool compute(float32 band, int32 length, Sequence sequence)
+  {
+    uint16 duty[::PwmController::CHANNELS_NUMBER];
+    if(!pwm_.mutex_.res.lock()) return false;
+    if(pwm_.task_.getFrequency() == ::Pwm::ERROR) return pwm_.mutex_.res.unlock(false);
+    // The scaling of the task period, which is used for the fast duty updating
+    int32 base = pwm_.compare_.base;
+    int32 scale = static_cast<int32>(pwm_.compare_.scale);
+    int32 sign = pwm_.compare_.sign;
+    nominal_[0] = pwm_.regPwm_->tbprd.val;
+    for(int32 i=0; i< ::PwmController::CHANNELS_NUMBER; i++)
+    {
+      nominal_[1 + i] = pwm_.regPwm_->cmp[i].val;
+      float32 value = pwm_.task_.getDuty(i);
+      duty[i] = value >= 100.0f ? 0x8000 : static_cast<uint16>(value * 327.68f);
+    }
+    pwm_.mutex_.res.unlock();
+    int32 dev = static_cast<int32>( static_cast<float32>(scale) * band / 100.0f );
+    if(dev < 1) return false;
+    if(scale - dev < SCALE_MIN || nominal_[0] + dev > 0xffff) return false;
+    ::PwmDitherSequence seq(dev, length, sequence == RANDOM);
+    for(int32 k=0; k<length; k++)
+    {
+      int32 offset = seq.next();
+      uint16* entry = &table_[ENTRY_SIZE * k];
+      entry[0] = static_cast<uint16>(nominal_[0] + offset);
+      // The inverse compare is counted from the period, which is shifted by the offset
+      int32 zero = base + (offset & sign);
+      uint32 period = static_cast<uint32>(scale + offset);
+      for(int32 i=0; i< ::PwmController::CHANNELS_NUMBER; i++)
+      {
+        entry[1 + i] = ::PwmDitherSequence::getCompare(period, duty[i], zero, sign);
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Writes an entry to the shadow registers.
+   *
+   * @param entry the period and compare values.
+   */
+  void write(const uint16* entry)
+  {
+    pwm_.regPwm_->tbprd.val = entry[0];
+    for(int32 i=0; i< ::PwmController::CHANNELS_NUMBER; i++) pwm_.regPwm_->cmp[i].val = entry[1 + i];
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  PwmDitherController(const PwmDitherController& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  PwmDitherController& operator =(const PwmDitherController& obj);
+
+  /**
+   * The PWM module.
+   */
+  ::PwmController& pwm_;
+
+  /**
+   * Max number of PWM periods in the sequence.
+   */
+  int32 capacity_;
+
+  /**
+   * Number of PWM periods in the current sequence.
+   */
+  int32 length_;
+
+  /**
+   * The index of next table entry.
+   */
+  volatile int32 index_;
+
+  /**
+   * The dither is started.
+   */
+  volatile bool isDithering_;
+
+  /**
+   * The table of the sequence.
+   */
+  uint16* table_;
+
+  /**
+   * The period and compare values of the assigned task.
+   */
+  uint16 nominal_[ENTRY_SIZE];
+
+};
+#endif // DRIVER_PWM_DITHER_CONTROLLER_HPP_
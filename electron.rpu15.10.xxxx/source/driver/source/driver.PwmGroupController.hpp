@@ -0,0 +1,484 @@
+/**
+ * TI TMS320F2833x DSP Enhanced Pulse Width Modulator group controller.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_PWM_GROUP_CONTROLLER_HPP_
+#define DRIVER_PWM_GROUP_CONTROLLER_HPP_
+
+#include "driver.Object.hpp"
+#include "driver.PwmController.hpp"
+
+class PwmGroupController : public ::Object, public ::Pwm::Group
+{
+  typedef ::Object                    Parent;
+  typedef ::PwmRegister::Tbctl::Val   Tbctl;
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param members an array of PWM modules created by the driver.
+   * @param number  a number of the PWM modules in the array.
+   */
+  PwmGroupController(::Pwm** members, int32 number) : Parent(),
+    number_ (0),
+    head_   (0){
+    setConstruct( construct(members, number) );
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~PwmGroupController()
+  {
+  }
+
+  /**
+   * Returns a number of the group members.
+   *
+   * @return the members number, or ERROR if error has been occurred.
+   */
+  virtual int32 getMembersNumber() const
+  {
+    return isConstructed() ? number_ : ::Pwm::ERROR;
+  }
+
+  /**
+   * Stages a task for a member.
+   *
+   * @param member an index of a member in the array passed to the create method.
+   * @param task   a new task of the member.
+   * @return true if the task has been staged successfully.
+   */
+  virtual bool setTask(int32 member, const ::Pwm::TaskInterface& task)
+  {
+    if(!isConstructed() || !isMember(member)) return false;
+    Member& mem = member_[member];
+    if(!mem.pwm->compile(task, mem.image)) return false;
+    mem.isImage = true;
+    return true;
+  }
+
+  /**
+   * Stages a register image for a member.
+   *
+   * @param member an index of a member in the array passed to the create method.
+   * @param image  a register image compiled by the member PWM module.
+   * @return true if the image has been staged successfully.
+   */
+  virtual bool setImage(int32 member, const ::Pwm::Image& image)
+  {
+    if(!isConstructed() || !isMember(member)) return false;
+    Member& mem = member_[member];
+    if(!mem.pwm->isImage(image)) return false;
+    mem.image = image;
+    mem.isImage = true;
+    return true;
+  }
+
+  /**
+   * Stages a phase shift time for a member.
+   *
+   * @param member an index of a member in the array passed to the create method.
+   * @param time   the PWN signals shift time during synchronization in ns.
+   * @return true if the phase has been staged successfully.
+   */
+  virtual bool setPhase(int32 member, int32 time)
+  {
+    if(time < 0) return false;
+    if(!isConstructed() || !isMember(member)) return false;
+    Member& mem = member_[member];
+    mem.pwm->splitPhase(mem.pwm->getPhaseSteps(time), mem.phase, mem.phaseHr);
+    mem.direction = ::Pwm::ERROR;
+    mem.isPhase = true;
+    return true;
+  }
+
+  /**
+   * Writes all staged values to the members.
+   *
+   * @param synchronize force a software synchronization pulse after writing.
+   * @return true if the staged values have been written successfully.
+   */
+  virtual bool commit(bool synchronize)
+  {
+    if(!isConstructed()) return false;
+    return commitStaged(synchronize);
+  }
+
+  /**
+   * Starts the members as an interleaved converter.
+   *
+   * @param frequency a frequency of the members in Hz.
+   * @return true if the members have been started successfully.
+   */
+  virtual bool interleave(int32 frequency)
+  {
+    if(frequency <= 0) return false;
+    if(!isConstructed()) return false;
+    // Compile the current tasks of the members with the new frequency
+    for(int32 i=0; i<number_; i++)
+    {
+      Member& mem = member_[i];
+      ::PwmController& pwm = *mem.pwm;
+      ::Pwm::TaskData< ::Pwm::Image::CHANNELS > data;
+      if(mem.isImage)
+      {
+        data = mem.image.task;
+      }
+      else
+      {
+        if(!pwm.mutex_.res.lock()) return false;
+        data.frequency = pwm.task_.getFrequency();
+        data.fraction = pwm.task_.getFraction();
+        for(int32 j=0; j< ::Pwm::Image::CHANNELS; j++) data.duty[j] = pwm.task_.getDuty(j);
+        pwm.mutex_.res.unlock();
+      }
+      data.frequency = frequency;
+      data.fraction = 0;
+      ::Pwm::Task< ::Pwm::Image::CHANNELS > task = data;
+      if(!pwm.compile(task, mem.image)) return false;
+      mem.isImage = true;
+    }
+    // Test all the members have the same period
+    const ::Pwm::Image& image = member_[0].image;
+    for(int32 i=1; i<number_; i++)
+    {
+      if(member_[i].image.clock != image.clock) return false;
+      if(member_[i].image.count != image.count) return false;
+      if(member_[i].image.tbprd != image.tbprd) return false;
+    }
+    // Count of time-base clocks of one period
+    int32 period = image.count == ::Pwm::UPDOWN ? 2 * image.tbprd : image.tbprd + 1;
+    for(int32 i=0; i<number_; i++)
+    {
+      Member& mem = member_[i];
+      // The order of the member in the synchronization chain
+      int32 order = 0;
+      for(int32 j=0; j<number_; j++)
+      {
+        if(member_[j].pwm->index_ < mem.pwm->index_) order++;
+      }
+      stagePhase(mem, period, order);
+      mem.isChain = true;
+    }
+    return commitStaged(true);
+  }
+
+  /**
+   * Forces a trip of all members by software.
+   *
+   * @param mode a trip mode.
+   */
+  virtual void trip(::Pwm::TripMode mode=::Pwm::TRIP_OSHT)
+  {
+    if(!isConstructed()) return;
+    uint16 value = ::PwmController::getTripBits(mode);
+    // The members are not locked for tripping them as soon as possible
+    System::eallow();
+    for(int32 i=0; i<number_; i++) member_[i].pwm->regPwm_->tzfrc.val = value;
+    System::dallow();
+  }
+
+private:
+
+  /**
+   * Writes all staged values to the members.
+   *
+   * @param synchronize force a software synchronization pulse after writing.
+   * @return true if the staged values have been written successfully.
+   */
+  bool commitStaged(bool synchronize)
+  {
+    bool res = true;
+    int32 locked;
+    // Lock all the members in the same order for excluding deadlocks
+    for(locked=0; locked<number_; locked++)
+    {
+      if(member_[locked].pwm->mutex_.res.lock()) continue;
+      res = false;
+      break;
+    }
+    if(res) res = write(synchronize);
+    while(locked-- > 0) member_[locked].pwm->mutex_.res.unlock();
+    return res;
+  }
+
+  /**
+   * A group member.
+   */
+  struct Member
+  {
+    /**
+     * Constructor.
+     */
+    Member() :
+      pwm       (NULL),
+      guard     (0),
+      phase     (0),
+      phaseHr   (0),
+      direction (::Pwm::ERROR),
+      isImage   (false),
+      isPhase   (false),
+      isChain   (false){
+    }
+
+    /**
+     * Destructor.
+     */
+   ~Member(){}
+
+    /**
+     * The PWM module.
+     */
+    ::PwmController* pwm;
+
+    /**
+     * Time-base clocks which are needed to write all members.
+     */
+    int32 guard;
+
+    /**
+     * Staged register image.
+     */
+    ::Pwm::Image image;
+
+    /**
+     * Staged phase register value.
+     */
+    uint16 phase;
+
+    /**
+     * Staged high resolution phase register value.
+     */
+    uint16 phaseHr;
+
+    /**
+     * Staged counter direction after synchronization, or ERROR for keeping current.
+     */
+    int32 direction;
+
+    /**
+     * The image is staged.
+     */
+    bool isImage;
+
+    /**
+     * The phase is staged.
+     */
+    bool isPhase;
+
+    /**
+     * The synchronization chain is staged.
+     */
+    bool isChain;
+
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param members an array of PWM modules created by the driver.
+   * @param number  a number of the PWM modules in the array.
+   * @return boolean result.
+   */
+  bool construct(::Pwm** members, int32 number)
+  {
+    if(!Parent::isConstructed()) return false;
+    if(members == NULL || number <= 0 || number > MAX_MEMBERS) return false;
+    for(int32 i=0; i<number; i++)
+    {
+      if(members[i] == NULL) return false;
+      // All PWM interfaces created by the driver are the PWM controllers
+      ::PwmController* pwm = static_cast< ::PwmController* >(members[i]);
+      if(!pwm->isConstructed()) return false;
+      for(int32 j=0; j<i; j++)
+      {
+        if(member_[j].pwm->index_ == pwm->index_) return false;
+      }
+      if(i > 0 && pwm->index_ < member_[head_].pwm->index_) head_ = i;
+      member_[i].pwm = pwm;
+      // Set the window with the writing time of all members in SYSCLKOUT clocks
+      member_[i].guard = PwmController::WRITING_CYCLES * number / (PwmController::sysclk_ / pwm->getMaxClock()) + 1;
+      number_++;
+    }
+    return true;
+  }
+
+  /**
+   * Writes all staged values to the members in the locked code section.
+   *
+   * @param synchronize force a software synchronization pulse after writing.
+   * @return true if the staged values have been written successfully.
+   */
+  bool write(bool synchronize)
+  {
+    // Test all the staged images before any writing
+    for(int32 i=0; i<number_; i++)
+    {
+      Member& mem = member_[i];
+      if(mem.isImage && !mem.pwm->isImage(mem.image)) return false;
+    }
+    bool is = Interrupt::globalDisable();
+    if(!wait()) return Interrupt::globalEnable(is, false);
+    for(int32 i=0; i<number_; i++)
+    {
+      Member& mem = member_[i];
+      PwmRegister* reg = mem.pwm->regPwm_;
+      if(mem.isImage) mem.pwm->writeImage(mem.image);
+      if(mem.isChain)
+      {
+        // The head synchronizes the others on each period, and the others pass the pulse through
+        reg->tbctl.bit.syncosel = i == head_ ? Tbctl::CTR_ZERO : Tbctl::SYNC_IN;
+        reg->tbctl.bit.phsen = i == head_ ? Tbctl::DISABLE : Tbctl::ENABLE;
+      }
+      if(mem.isPhase) 
+      {
+        reg->tbphs.val = mem.phase;
+        if(mem.direction != ::Pwm::ERROR) reg->tbctl.bit.phsdir = mem.direction;
+        #ifdef DRIVER_HRPWM
+        if(mem.pwm->isHiResPhase_) reg->tbphshr.bit.tbphsh = mem.phaseHr;
+        #endif // DRIVER_HRPWM
+      }
+    }
+    if(synchronize) member_[head_].pwm->regPwm_->tbctl.bit.swfsync = 1;
+    Interrupt::globalEnable(is);
+    for(int32 i=0; i<number_; i++)
+    {
+      member_[i].isImage = false;
+      member_[i].isPhase = false;
+      member_[i].isChain = false;
+    }
+    return true;
+  }
+
+  /**
+   * Stages an interleaved phase of a member.
+   *
+   * The member lags the head of the chain by order/N of the period,
+   * and the phase is calculated in 1/256 of time-base clock.
+   *
+   * @param mem    a member.
+   * @param period count of time-base clocks of one period.
+   * @param order  the order of the member in the synchronization chain.
+   */
+  void stagePhase(Member& mem, int32 period, int32 order)
+  {
+    int32 lag = (period * order << 8) / number_;
+    int32 value, direction;
+    // Convert the lag to the counter value at the synchronization event
+    switch(mem.image.count)
+    {
+      case ::Pwm::UP:
+      {
+        value = lag == 0 ? 0 : (period << 8) - lag;
+        direction = ::Pwm::ERROR;
+      }
+      break;
+      case ::Pwm::DOWN:
+      {
+        value = lag;
+        direction = ::Pwm::ERROR;
+      }
+      break;
+      default:
+      {
+        // The counter is counting up on the first half of the period
+        value = lag == 0 ? 0 : (period << 8) - lag;
+        direction = 1;
+        if(value > (period << 7))
+        {
+          value = lag;
+          direction = 0;
+        }
+      }
+      break;
+    }
+    mem.phase = static_cast<uint16>(value >> 8);
+    mem.phaseHr = 0;
+    mem.direction = direction;
+    #ifdef DRIVER_HRPWM
+    // The high resolution phase is valid only in the up-count mode
+    if(mem.pwm->isHiResPhase_ && mem.image.count == ::Pwm::UP)
+    {
+      int32 mep = mem.pwm->getMep();
+      if(mep != ::Pwm::ERROR) mem.phaseHr = static_cast<uint16>(((value & 0xff) * mep + 0x80) >> 8);
+    }
+    #endif // DRIVER_HRPWM
+    mem.isPhase = true;
+  }
+
+  /**
+   * Waits a window where all members may be written before next counter-equal-zero event.
+   *
+   * @return true if the window has been found before two periods elapsed.
+   */
+  bool wait() const
+  {
+    int32 prev = ::Pwm::ERROR;
+    int32 wraps = 0;
+    while(true)
+    {
+      int32 first = ::Pwm::ERROR;
+      bool window = true;
+      for(int32 i=0; i<number_; i++)
+      {
+        int32 dist = member_[i].pwm->getLoadDistance();
+        // A stopped member loads shadow registers when it will be started
+        if(dist == ::Pwm::ERROR) continue;
+        if(first == ::Pwm::ERROR) first = dist;
+        if(dist <= member_[i].guard) window = false;
+      }
+      if(window) return true;
+      // Count zero events of the first running member for breaking the waiting
+      if(prev != ::Pwm::ERROR && first > prev) wraps++;
+      if(wraps > 2) return false;
+      prev = first;
+    }
+  }
+
+  /**
+   * Tests if passed value is a member index.
+   *
+   * @param member a member index.
+   * @return true if the member index is available.
+   */
+  bool isMember(int32 member) const
+  {
+    return 0 <= member && member < number_ ? true : false;
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  PwmGroupController(const PwmGroupController& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  PwmGroupController& operator =(const PwmGroupController& obj);
+
+  /**
+   * The members.
+   */
+  Member member_[MAX_MEMBERS];
+
+  /**
+   * The members number.
+   */
+  int32 number_;
+
+  /**
+   * Index of the member with the smallest PWM module number.
+   */
+  int32 head_;
+
+};
+#endif // DRIVER_PWM_GROUP_CONTROLLER_HPP_
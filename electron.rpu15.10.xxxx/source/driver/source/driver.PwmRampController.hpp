@@ -0,0 +1,492 @@
+/**
+ * TI TMS320F2833x DSP Enhanced Pulse Width Modulator ramp generator controller.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_PWM_RAMP_CONTROLLER_HPP_
+#define DRIVER_PWM_RAMP_CONTROLLER_HPP_
+
+#include "driver.Object.hpp"
+#include "driver.InterruptTask.hpp"
+#include "driver.PwmController.hpp"
+
+class PwmRampController : public ::Object, public ::Pwm::Ramp, public ::InterruptTask
+{
+  typedef ::Object  Parent;
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param members an array of PWM modules created by the driver.
+   * @param number  a number of the PWM modules in the array.
+   */
+  PwmRampController(::Pwm** members, int32 number) : Parent(), ::InterruptTask(),
+    number_    (0),
+    quantity_  (DUTY),
+    shape_     (LINEAR),
+    channel_   (0),
+    periods_   (0),
+    step_      (0),
+    isRamping_ (false),
+    handler_   (NULL){
+    setConstruct( construct(members, number) );
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~PwmRampController()
+  {
+    stop();
+  }
+
+  /**
+   * Returns a number of the generator members.
+   *
+   * @return the members number, or ERROR if error has been occurred.
+   */
+  virtual int32 getMembersNumber() const
+  {
+    return isConstructed() ? number_ : ::Pwm::ERROR;
+  }
+
+  /**
+   * Stages a target value for a member.
+   *
+   * @param member an index of a member in the array passed to the create method.
+   * @param target a target value in units of the quantity of the ramp.
+   * @return true if the target has been staged successfully.
+   */
+  virtual bool setTarget(int32 member, float32 target)
+  {
+    if(!isConstructed() || isRamping_) return false;
+    if(member < 0 || member >= number_) return false;
+    member_[member].target = target;
+    member_[member].isTarget = true;
+    return true;
+  }
+
+  /**
+   * Starts a ramp of the staged targets.
+   *
+   * @param quantity a ramped value.
+   * @param channel  a channel number of the duty, which is ignored for other values.
+   * @param periods  a number of PWM periods of the first member of the ramp.
+   * @param shape    a profile of the ramp.
+   * @return true if the ramp has been started successfully.
+   */
+  virtual bool start(Quantity quantity, int32 channel, int32 periods, Shape shape=LINEAR)
+  {
+    if(!isConstructed() || isRamping_) return false;
+    if(periods <= 0) return false;
+    if(quantity == DUTY && (channel < 0 || channel >= ::PwmController::CHANNELS_NUMBER)) return false;
+    quantity_ = quantity;
+    channel_ = channel;
+    for(int32 i=0; i<number_; i++)
+    {
+      Member& mem = member_[i];
+      if(!readValue(mem)) return false;
+      if(!mem.isTarget) mem.target = mem.begin;
+      if(!isCorrect(mem)) return false;
+      mem.delta = mem.target - mem.begin;
+    }
+    shape_ = shape;
+    periods_ = periods;
+    step_ = 0;
+    isRamping_ = true;
+    // The values are written after the counter-equal-zero event loads the previous ones
+    if(!member_[0].pwm->getTrigger().setInterrupt(*this, ::Pwm::CTR_ZERO, 1))
+    {
+      isRamping_ = false;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Stops a ramp.
+   */
+  virtual void stop()
+  {
+    if(!isConstructed()) return;
+    bool is = Interrupt::globalDisable();
+    bool isRamping = isRamping_;
+    isRamping_ = false;
+    Interrupt::globalEnable(is);
+    if(!isRamping) return;
+    member_[0].pwm->getTrigger().resetInterrupt();
+    resetTargets();
+  }
+
+  /**
+   * Tests if a ramp is going.
+   *
+   * @return true if the ramp has not been completed.
+   */
+  virtual bool isRamping() const
+  {
+    return isRamping_;
+  }
+
+  /**
+   * Sets a ramp completion handler.
+   *
+   * @param handler a user handler.
+   * @return true if the handler has been set successfully.
+   */
+  virtual bool setHandler(::InterruptTask& handler)
+  {
+    if(!isConstructed()) return false;
+    handler_ = &handler;
+    return true;
+  }
+
+  /**
+   * Resets the ramp completion handler.
+   */
+  virtual void resetHandler()
+  {
+    handler_ = NULL;
+  }
+
+  /**
+   * Writes the values of next ramp step.
+   *
+   * The method is called by the interrupt of the first member.
+   */
+  virtual void handler()
+  {
+    if(!isRamping_) return;
+    int32 step = step_ + 1;
+    step_ = step;
+    float32 part = static_cast<float32>(step) / static_cast<float32>(periods_);
+    if(shape_ == S_CURVE) part = part * part * (3.0f - 2.0f * part);
+    bool last = step >= periods_;
+    for(int32 i=0; i<number_; i++)
+    {
+      Member& mem = member_[i];
+      // The targets are written exactly on the last step
+      if(last && quantity_ == DUTY)
+      {
+        writeTask(mem);
+        continue;
+      }
+      float32 value = last ? mem.target : mem.begin + mem.delta * part;
+      write(mem, value);
+    }
+    if(!last) return;
+    isRamping_ = false;
+    member_[0].pwm->getTrigger().resetInterrupt();
+    resetTargets();
+    if(handler_ != NULL) handler_->handler();
+  }
+
+  /**
+   * Tests if this object has been constructed.
+   *
+   * @return true if object has been constructed successfully.
+   */
+  virtual bool isConstructed() const
+  {
+    return this->Parent::isConstructed();
+  }
+
+private:
+
+  /**
+   * A member of the generator.
+   */
+  struct Member
+  {
+    /**
+     * The PWM module.
+     */
+    ::PwmController* pwm;
+
+    /**
+     * The value at the ramp start.
+     */
+    float32 begin;
+
+    /**
+     * The target value.
+     */
+    float32 target;
+
+    /**
+     * The difference between the target and start values.
+     */
+    float32 delta;
+
+    /**
+     * The target has been staged.
+     */
+    bool isTarget;
+
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param members an array of PWM modules created by the driver.
+   * @param number  a number of the PWM modules in the array.
+   * @return boolean result.
+   */
+  bool construct(::Pwm** members, int32 number)
+  {
+    if(!Parent::isConstructed()) return false;
+    if(members == NULL || number <= 0 || number > MAX_MEMBERS) return false;
+    for(int32 i=0; i<number; i++)
+    {
+      if(members[i] == NULL) return false;
+      // All PWM interfaces created by the driver are the PWM controllers
+      ::PwmController* pwm = static_cast< ::PwmController* >(members[i]);
+      if(!pwm->isConstructed()) return false;
+      for(int32 j=0; j<i; j++)
+      {
+        if(member_[j].pwm->index_ == pwm->index_) return false;
+      }
+      member_[i].pwm = pwm;
+      member_[i].begin = 0.0f;
+      member_[i].target = 0.0f;
+      member_[i].delta = 0.0f;
+      member_[i].isTarget = false;
+      number_++;
+    }
+    return true;
+  }
+
+  /**
+   * Reads the current value of a member.
+   *
+   * @param mem a member.
+   * @return true if the value has been read successfully.
+   */
+  bool readValue(Member& mem)
+  {
+    ::PwmController& pwm = *mem.pwm;
+    float32 value;
+    switch(quantity_)
+    {
+      case DUTY:
+      {
+        value = pwm.getDuty(channel_, false);
+      }
+      break;
+      case FREQUENCY:
+      {
+        if(!pwm.mutex_.res.lock()) return false;
+        int32 freq = pwm.task_.getFrequency();
+        uint16 frac = pwm.task_.getFraction();
+        pwm.mutex_.res.unlock();
+        if(freq == ::Pwm::ERROR) return false;
+        value = ::PwmController::getHertz(freq, frac);
+      }
+      break;
+      case PHASE:
+      {
+        value = static_cast<float32>( pwm.getPhase() );
+      }
+      break;
+      default: return false;
+    }
+    if(value == ::Pwm::ERROR) return false;
+    mem.begin = value;
+    return true;
+  }
+
+  /**
+   * Tests if the target of a member is correct.
+   *
+   * @param mem a member.
+   * @return true if the target might be written.
+   */
+  bool isCorrect(const Member& mem) const
+  {
+    switch(quantity_)
+    {
+      case DUTY: return mem.target >= 0.0f && mem.target <= 100.0f;
+      case PHASE: return mem.target >= 0.0f;
+      case FREQUENCY:
+      {
+        if(mem.target < 1.0f) return false;
+        ::Pwm::Task< ::PwmController::CHANNELS_NUMBER > task;
+        ::Pwm::Image image;
+        if(!getTask(mem, mem.target, task)) return false;
+        if(!mem.pwm->compile(task, image)) return false;
+        // The clock dividers have no shadow registers
+        if(image.clock != mem.pwm->tbclk_) return false;
+        // The periods are written in the load window
+        return mem.pwm->isWindow() && mem.pwm->isWindow(image);
+      }
+      default: return false;
+    }
+  }
+
+  /**
+   * Writes a value to a member.
+   *
+   * This is important, the method is called in the interrupt context.
+   *
+   * @param mem   a member.
+   * @param value a value.
+   */
+  void write(Member& mem, float32 value)
+  {
+    ::PwmController& pwm = *mem.pwm;
+    switch(quantity_)
+    {
+      case DUTY:
+      {
+        uint16 duty = value >= 100.0f ? 0x8000 : static_cast<uint16>(value * 327.68f);
+        pwm.setDuty(channel_, duty);
+      }
+      break;
+      case FREQUENCY:
+      {
+        ::Pwm::Task< ::PwmController::CHANNELS_NUMBER > task;
+        ::Pwm::Image image;
+        if(!getTask(mem, value, task)) return;
+        if(!pwm.compileImage(task, image)) return;
+        if(image.clock != pwm.tbclk_) return;
+        bool is = Interrupt::globalDisable();
+        // The step is skipped if no window has been found, and next step writes its value
+        if(pwm.waitWindow()) pwm.writeImage(image);
+        Interrupt::globalEnable(is);
+      }
+      break;
+      case PHASE:
+      {
+        pwm.setPhase( static_cast<int32>(value + 0.5f) );
+      }
+      break;
+    }
+  }
+
+  /**
+   * Returns the current task of a member with a new frequency.
+   *
+   * @param mem       a member.
+   * @param frequency a frequency in Hz.
+   * @param task      a task to be filled.
+   * @return true if the task has been filled successfully.
+   */
+  static bool getTask(const Member& mem, float32 frequency, ::Pwm::Task< ::PwmController::CHANNELS_NUMBER >& task)
+  {
+    ::PwmController& pwm = *mem.pwm;
+    ::Pwm::TaskData< ::PwmController::CHANNELS_NUMBER > data;
+    data.frequency = static_cast<int32>(frequency);
+    data.fraction = static_cast<uint16>( (frequency - static_cast<float32>(data.frequency)) * 65536.0f );
+    for(int32 i=0; i< ::PwmController::CHANNELS_NUMBER; i++)
+    {
+      data.duty[i] = pwm.task_.getDuty(i);
+      if(data.duty[i] == ::Pwm::ERROR) return false;
+    }
+    task = data;
+    return true;
+  }
+
+  /**
+   * Writes the task of a member with the target duty.
+   *
+   * The compiled task image updates the high resolution compare and edge delay 
+   * of the member, which are not written by the fast duty path of the ramp steps.
+   * This is important, the method is called in the interrupt context.
+   *
+   * @param mem a member.
+   */
+  void writeTask(Member& mem)
+  {
+    ::PwmController& pwm = *mem.pwm;
+    ::Pwm::TaskData< ::PwmController::CHANNELS_NUMBER > data;
+    data.frequency = pwm.task_.getFrequency();
+    data.fraction = pwm.task_.getFraction();
+    for(int32 i=0; i< ::PwmController::CHANNELS_NUMBER; i++) data.duty[i] = pwm.task_.getDuty(i);
+    data.duty[channel_] = mem.target;
+    ::Pwm::Task< ::PwmController::CHANNELS_NUMBER > task = data;
+    ::Pwm::Image image;
+    bool is = Interrupt::globalDisable();
+    if(pwm.compileImage(task, image) && image.clock == pwm.tbclk_ && pwm.waitWindow())
+    {
+      pwm.writeImage(image);
+      Interrupt::globalEnable(is);
+      return;
+    }
+    Interrupt::globalEnable(is);
+    // The task is kept for the fast duty path without the high resolution part
+    write(mem, mem.target);
+    pwm.task_ = data;
+  }
+
+  /**
+   * Resets the staged targets.
+   */
+  void resetTargets()
+  {
+    for(int32 i=0; i<number_; i++) member_[i].isTarget = false;
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  PwmRampController(const PwmRampController& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  PwmRampController& operator =(const PwmRampController& obj);
+
+  /**
+   * The members.
+   */
+  Member member_[MAX_MEMBERS];
+
+  /**
+   * Number of the members.
+   */
+  int32 number_;
+
+  /**
+   * The ramped value.
+   */
+  Quantity quantity_;
+
+  /**
+   * The ramp profile.
+   */
+  Shape shape_;
+
+  /**
+   * The channel number of the ramped duty.
+   */
+  int32 channel_;
+
+  /**
+   * Number of the ramp steps.
+   */
+  int32 periods_;
+
+  /**
+   * The current ramp step.
+   */
+  volatile int32 step_;
+
+  /**
+   * The ramp is going.
+   */
+  volatile bool isRamping_;
+
+  /**
+   * The ramp completion handler.
+   */
+  ::InterruptTask* handler_;
+
+};
+#endif // DRIVER_PWM_RAMP_CONTROLLER_HPP_
@@ -339,6 +339,12 @@ public:
     uint16 val;
     struct Val 
     {
+      // RLDCSF bits
+      static const uint16 LOAD_CTR_EQ_ZERO = 0x0;
+      static const uint16 LOAD_CTR_EQ_PRD  = 0x1;
+      static const uint16 LOAD_CTR_EQ_BOTH = 0x2;
+      static const uint16 LOAD_IMMEDIATE   = 0x3;
+      
       uint16 actsfa : 2;  
       uint16 otsfa  : 1;
       uint16 actsfb : 2;
@@ -0,0 +1,338 @@
+/**
+ * TI TMS320F2833x DSP Enhanced Pulse Width Modulator sinusoidal generator controller.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_PWM_SINE_CONTROLLER_HPP_
+#define DRIVER_PWM_SINE_CONTROLLER_HPP_
+
+#include "driver.Object.hpp"
+#include "driver.PwmController.hpp"
+
+class PwmSineController : public ::Object, public ::Pwm::Sine
+{
+  typedef ::Object  Parent;
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param pwm      a PWM module created by the driver.
+   * @param table    a sine table of one period in Q15 format.
+   * @param length   a number of the table elements.
+   * @param capacity max number of PWM periods in one output wave period.
+   * @param issue    the SOC signal which triggers the DMA channel.
+   */
+  PwmSineController(::Pwm& pwm, const int16* table, int32 length, int32 capacity, ::Pwm::TriggerIssue issue) : Parent(),
+    // All PWM interfaces created by the driver are the PWM controllers
+    pwm_       (static_cast< ::PwmController& >(pwm)),
+    table_     (table),
+    length_    (length),
+    capacity_  (capacity),
+    issue_     (issue),
+    samples_   (0),
+    frequency_ (0.0f),
+    isStarted_ (false),
+    isLocked_  (false){
+    buffer_[0] = NULL;
+    buffer_[1] = NULL;
+    setConstruct( construct() );
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~PwmSineController()
+  {
+    stop();
+    if(buffer_[0] != NULL) delete[] buffer_[0];
+    if(buffer_[1] != NULL) delete[] buffer_[1];
+    if(isLocked_) ::PwmController::dmaLock_[pwm_.index_] = false;
+  }
+
+  /**
+   * Sets a wave and starts the generator if it is not started.
+   *
+   * @param index     a modulation index from 0.0 to 1.0.
+   * @param frequency a frequency of the output wave in Hz.
+   * @return true if the wave has been set successfully.
+   */
+  virtual bool setWave(float32 index, int32 frequency)
+  {
+    if(!isConstructed()) return false;
+    if(index < 0.0f || index > 1.0f || frequency <= 0) return false;
+    int32 carrier = pwm_.getSignalFrequency(false);
+    if(carrier == ::Pwm::ERROR) return false;
+    // Round the number of PWM periods in one output wave period
+    int32 samples = (carrier + frequency / 2) / frequency;
+    if(samples < SAMPLES_MIN || samples > capacity_) return false;
+    uint16 modulation = static_cast<uint16>(index * 32767.0f);
+    DmaRegister::Channel& ch = ::PwmController::regDma_->ch[pwm_.index_];
+    if(isStarted_)
+    {
+      // The DMA has not started a transfer from the buffer of a previous wave
+      if(ch.srcBegAddrShadow != ch.srcBegAddrActive) return false;
+      uint16* buffer = getAddress(buffer_[0]) == ch.srcBegAddrActive ? buffer_[1] : buffer_[0];
+      if(!sample(buffer, samples, modulation)) return false;
+      // The shadow registers are loaded by the DMA at next transfer start on the SOC event
+      bool is = Interrupt::globalDisable();
+      if(!pwm_.waitWindow())
+      {
+        Interrupt::globalEnable(is);
+        return false;
+      }
+      System::eallow();
+      ch.srcBegAddrShadow = getAddress(buffer);
+      ch.srcAddrShadow = getAddress(buffer);
+      ch.transferSize = static_cast<uint16>(samples - 1);
+      System::dallow();
+      Interrupt::globalEnable(is);
+    }
+    else
+    {
+      if(!sample(buffer_[0], samples, modulation)) return false;
+      start(samples);
+      if(!pwm_.setEvent(issue_, ::Pwm::CTR_ZERO))
+      {
+        halt();
+        return false;
+      }
+      isStarted_ = true;
+    }
+    samples_ = samples;
+    frequency_ = static_cast<float32>(carrier) / static_cast<float32>(samples);
+    return true;
+  }
+
+  /**
+   * Stops the generator.
+   */
+  virtual void stop()
+  {
+    if(!isConstructed() || !isStarted_) return;
+    pwm_.resetEvent(issue_);
+    halt();
+    isStarted_ = false;
+    samples_ = 0;
+    frequency_ = 0.0f;
+  }
+
+  /**
+   * Returns the output wave frequency.
+   *
+   * @return the real frequency in Hz, or ERROR if the generator is not started.
+   */
+  virtual float32 getFrequency() const
+  {
+    if(!isConstructed() || !isStarted_) return ::Pwm::ERROR;
+    return frequency_;
+  }
+
+private:
+
+  /**
+   * Min number of PWM periods in one output wave period.
+   */
+  static const int32 SAMPLES_MIN = 2;
+
+  /**
+   * Max number of the sine table elements.
+   */
+  static const int32 TABLE_LENGTH_MAX = 0x7fff;
+
+  /**
+   * Number of words written to the counter-compare registers on one event.
+   */
+  static const int32 BURST_SIZE = 2;
+
+  /**
+   * DMA peripheral interrupt of the ePWM1 SOCA signal.
+   */
+  static const int32 PERINTSEL_EPWM1_SOCA = 18;
+
+  /**
+   * Constructor.
+   *
+   * @return boolean result.
+   */
+  bool construct()
+  {
+    #ifdef DRIVER_PWM_DMA
+    if(!Parent::isConstructed()) return false;
+    if(!pwm_.isConstructed()) return false;
+    if(table_ == NULL || length_ <= 0 || length_ > TABLE_LENGTH_MAX) return false;
+    if(capacity_ < SAMPLES_MIN || capacity_ > 0x10000) return false;
+    if(issue_ != ::Pwm::ADC_SOCA && issue_ != ::Pwm::ADC_SOCB) return false;
+    // The heap memory has to be accessible by the DMA
+    for(int32 i=0; i<2; i++)
+    {
+      buffer_[i] = new uint16[capacity_ * BURST_SIZE];
+      if(buffer_[i] == NULL) return false;
+    }
+    // The DMA channel with the number of the PWM module is used
+    bool is = Interrupt::globalDisable();
+    bool res = ::PwmController::dmaLock_[pwm_.index_] == false;
+    ::PwmController::dmaLock_[pwm_.index_] = true;
+    Interrupt::globalEnable(is);
+    isLocked_ = res;
+    return res;
+    #else  // DRIVER_PWM_DMA
+    return false;
+    #endif // DRIVER_PWM_DMA
+  }
+
+  /**
+   * Samples the sine table to a buffer of the compare values.
+   *
+   * @param buffer     a buffer for pairs of channels A and B compare values.
+   * @param samples    a number of PWM periods in one output wave period.
+   * @param modulation a modulation index in Q15 format.
+   * @return true if the buffer has been sampled successfully.
+   */
+  bool sample(uint16* buffer, int32 samples, uint16 modulation)
+  {
+    // Step of the table index for one PWM period in Q16 format
+    uint32 step = ( static_cast<uint32>(length_) << 16 ) / static_cast<uint32>(samples);
+    uint32 phase = 0;
+    if(!pwm_.mutex_.res.lock()) return false;
+    for(int32 i=0; i<samples; i++)
+    {
+      int32 sine = table_[phase >> 16];
+      // The product of Q15 values is in Q30, and its half is in Q15 after the shift
+      int32 half = ( sine * static_cast<int32>(modulation) ) >> 16;
+      buffer[BURST_SIZE * i + 0] = pwm_.getCompare( static_cast<uint16>(0x4000 + half) );
+      buffer[BURST_SIZE * i + 1] = pwm_.getCompare( static_cast<uint16>(0x4000 - half) );
+      phase += step;
+    }
+    pwm_.mutex_.res.unlock();
+    return true;
+  }
+
+  /**
+   * Starts the DMA channel with the first buffer.
+   *
+   * @param samples a number of PWM periods in one output wave period.
+   */
+  void start(int32 samples)
+  {
+    DmaRegister::Channel& ch = ::PwmController::regDma_->ch[pwm_.index_];
+    uint32 src = getAddress(buffer_[0]);
+    uint32 dst = getAddress(&pwm_.regPwm_->cmp[0]);
+    System::eallow();
+    ch.control.bit.softreset = 1;
+    ch.mode.val = 0x0000;
+    ch.mode.bit.perintsel = PERINTSEL_EPWM1_SOCA + 2 * pwm_.index_ + (issue_ == ::Pwm::ADC_SOCB ? 1 : 0);
+    ch.mode.bit.perinte = 1;
+    ch.mode.bit.continuous = 1;
+    // One burst writes CMPA and CMPB, and returns the destination address to CMPA
+    ch.burstSize = BURST_SIZE - 1;
+    ch.srcBurstStep = 1;
+    ch.dstBurstStep = 1;
+    ch.transferSize = static_cast<uint16>(samples - 1);
+    ch.srcTransferStep = 1;
+    ch.dstTransferStep = -1;
+    // Disable the wrapping as a transfer is no more than the capacity
+    ch.srcWrapSize = 0xffff;
+    ch.srcWrapStep = 0;
+    ch.dstWrapSize = 0xffff;
+    ch.dstWrapStep = 0;
+    ch.srcBegAddrShadow = src;
+    ch.srcAddrShadow = src;
+    ch.dstBegAddrShadow = dst;
+    ch.dstAddrShadow = dst;
+    ch.control.bit.perintclr = 1;
+    ch.control.bit.errclr = 1;
+    ch.control.bit.run = 1;
+    System::dallow();
+  }
+
+  /**
+   * Halts the DMA channel.
+   */
+  void halt()
+  {
+    System::eallow();
+    ::PwmController::regDma_->ch[pwm_.index_].control.bit.halt = 1;
+    System::dallow();
+  }
+
+  /**
+   * Returns an address of a memory for the DMA.
+   *
+   * @param ptr a pointer to the memory.
+   * @return the address.
+   */
+  template <typename Type>
+  static uint32 getAddress(Type* ptr)
+  {
+    return reinterpret_cast<uint32>(ptr);
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  PwmSineController(const PwmSineController& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  PwmSineController& operator =(const PwmSineController& obj);
+
+  /**
+   * The PWM module.
+   */
+  ::PwmController& pwm_;
+
+  /**
+   * The sine table.
+   */
+  const int16* table_;
+
+  /**
+   * The sine table length.
+   */
+  int32 length_;
+
+  /**
+   * Max number of PWM periods in one output wave period.
+   */
+  int32 capacity_;
+
+  /**
+   * The SOC signal which triggers the DMA channel.
+   */
+  ::Pwm::TriggerIssue issue_;
+
+  /**
+   * Number of PWM periods in current output wave period.
+   */
+  int32 samples_;
+
+  /**
+   * The real output wave frequency.
+   */
+  float32 frequency_;
+
+  /**
+   * The generator has been started.
+   */
+  bool isStarted_;
+
+  /**
+   * The DMA channel has been locked by this generator.
+   */
+  bool isLocked_;
+
+  /**
+   * Two buffers of compare values.
+   */
+  uint16* buffer_[2];
+
+};
+#endif // DRIVER_PWM_SINE_CONTROLLER_HPP_
@@ -0,0 +1,184 @@
+/**
+ * TI TMS320F2833x DSP Enhanced Pulse Width Modulator space vector modulator controller.
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#ifndef DRIVER_PWM_VECTOR_CONTROLLER_HPP_
+#define DRIVER_PWM_VECTOR_CONTROLLER_HPP_
+
+#include <math.h>
+#include "driver.Object.hpp"
+#include "driver.PwmController.hpp"
+#include "driver.PwmVectorModulation.hpp"
+
+class PwmVectorController : public ::Object, public ::Pwm::SpaceVector
+{
+  typedef ::Object                    Parent;
+  typedef ::PwmRegister::Tbctl::Val   Tbctl;
+
+public:
+
+  /**
+   * Constructor.
+   *
+   * @param phases an array of three PWM modules for the phases A, B and C.
+   */
+  PwmVectorController(::Pwm** phases) : Parent(),
+    sector_ (::Pwm::ERROR){
+    setConstruct( construct(phases) );
+  }
+
+  /**
+   * Destructor.
+   */
+  virtual ~PwmVectorController()
+  {
+  }
+
+  /**
+   * Sets a voltage reference in the stationary frame.
+   *
+   * @param alpha an alpha component normalized to the DC link voltage.
+   * @param beta  a beta component normalized to the DC link voltage.
+   * @return true if the compare values have been written successfully.
+   */
+  virtual bool setVoltage(float32 alpha, float32 beta)
+  {
+    if(!isConstructed()) return false;
+    // The window of the first module is common for all while their periods are the same
+    if(!isPeriod()) return false;
+    uint16 duty[PHASES_NUMBER];
+    int32 sector = ::PwmVectorModulation::modulate(alpha, beta, duty);
+    uint16 cmp[PHASES_NUMBER];
+    for(int32 i=0; i<PHASES_NUMBER; i++) cmp[i] = phase_[i]->getCompare(duty[i]);
+    bool is = Interrupt::globalDisable();
+    if(!phase_[0]->waitWindow())
+    {
+      Interrupt::globalEnable(is);
+      return false;
+    }
+    for(int32 i=0; i<PHASES_NUMBER; i++) phase_[i]->regPwm_->cmp[0].val = cmp[i];
+    Interrupt::globalEnable(is);
+    sector_ = sector;
+    return true;
+  }
+
+  /**
+   * Sets a voltage reference by its magnitude and angle.
+   *
+   * @param magnitude a magnitude normalized to the DC link voltage.
+   * @param angle     an angle from the phase A axis in radians.
+   * @return true if the compare values have been written successfully.
+   */
+  virtual bool setPolar(float32 magnitude, float32 angle)
+  {
+    if(magnitude < 0.0f) return false;
+    float32 alpha = magnitude * static_cast<float32>( cos(angle) );
+    float32 beta = magnitude * static_cast<float32>( sin(angle) );
+    return setVoltage(alpha, beta);
+  }
+
+  /**
+   * Returns the sector of the last voltage reference.
+   *
+   * @return the sector from 1 to 6, or ERROR if no reference has been set.
+   */
+  virtual int32 getSector() const
+  {
+    return isConstructed() ? sector_ : ::Pwm::ERROR;
+  }
+
+private:
+
+  /**
+   * Constructor.
+   *
+   * @param phases an array of three PWM modules for the phases A, B and C.
+   * @return boolean result.
+   */
+  bool construct(::Pwm** phases)
+  {
+    if(!Parent::isConstructed()) return false;
+    if(phases == NULL) return false;
+    for(int32 i=0; i<PHASES_NUMBER; i++)
+    {
+      if(phases[i] == NULL) return false;
+      // All PWM interfaces created by the driver are the PWM controllers
+      ::PwmController* pwm = static_cast< ::PwmController* >(phases[i]);
+      if(!pwm->isConstructed()) return false;
+      if(pwm->getCountPolicy() != ::Pwm::UPDOWN) return false;
+      for(int32 j=0; j<i; j++)
+      {
+        if(phase_[j]->index_ == pwm->index_) return false;
+      }
+      phase_[i] = pwm;
+    }
+    return isPeriod() && isSynchronized();
+  }
+
+  /**
+   * Tests if the modules have the same started period.
+   *
+   * @return true if the periods are the same.
+   */
+  bool isPeriod() const
+  {
+    uint16 tbprd = phase_[0]->regPwm_->tbprd.val;
+    if(tbprd == 0) return false;
+    for(int32 i=1; i<PHASES_NUMBER; i++)
+    {
+      if(phase_[i]->regPwm_->tbprd.val != tbprd) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Tests if the time-base counters of the modules are synchronized without a phase shift.
+   *
+   * One module might be a head of a synchronization chain, which does not load its counter, 
+   * and others have to load the zero phase on the synchronization event.
+   *
+   * @return true if the counters are synchronized.
+   */
+  bool isSynchronized() const
+  {
+    int32 heads = 0;
+    for(int32 i=0; i<PHASES_NUMBER; i++)
+    {
+      ::PwmRegister* reg = phase_[i]->regPwm_;
+      if(reg->tbphs.val != 0) return false;
+      if(reg->tbctl.bit.phsen == Tbctl::ENABLE) continue;
+      // The head has to pass the synchronization to other modules
+      if(reg->tbctl.bit.syncosel == Tbctl::SYNC_DISABLE) return false;
+      heads++;
+    }
+    return heads <= 1;
+  }
+
+  /**
+   * Copy constructor.
+   *
+   * @param obj reference to source object.
+   */
+  PwmVectorController(const PwmVectorController& obj);
+
+  /**
+   * Assignment operator.
+   *
+   * @param obj reference to source object.
+   * @return reference to this object.
+   */
+  PwmVectorController& operator =(const PwmVectorController& obj);
+
+  /**
+   * The PWM modules of the phases.
+   */
+  ::PwmController* phase_[PHASES_NUMBER];
+
+  /**
+   * The sector of the last voltage reference.
+   */
+  int32 sector_;
+
+};
+#endif // DRIVER_PWM_VECTOR_CONTROLLER_HPP_
@@ -40,19 +40,20 @@ const int32 ADC_RESULTS = 2;
 typedef Adc::Task<ADC_BLOCKS, ADC_SEQUENCES, ADC_CHANNELS, ADC_RESULTS> AdcTask;
 
 /**
- * Starts new PWM task.
+ * Stages new PWM task in a group.
  *
- * @param pwm       a PWM module. 
+ * @param group     a group of PWM modules. 
+ * @param member    a PWM module index in the group.
  * @param frequency task frequency in Hz.
  * @param duty0     first channel duty in percentages.
  * @param duty1     second channel duty in percentages.
- * @return true if the task has been started successfully.
+ * @return true if the task has been staged successfully.
  */   
-static bool setPwmTask(Pwm& pwm, int32 frequency, float32 duty0, float32 duty1)
+static bool setPwmTask(Pwm::Group& group, int32 member, int32 frequency, float32 duty0, float32 duty1)
 {
-  Pwm::TaskData<PWM_CHANNELS> data = {frequency, duty0, duty1};
+  Pwm::TaskData<PWM_CHANNELS> data = {frequency, duty0, duty1, 0};
   Pwm::Task<PWM_CHANNELS> task = data;
-  return pwm.setTask(task);  
+  return group.setTask(member, task);  
 }
 
 /**
@@ -154,6 +155,7 @@ int _main()
   volatile bool exe = true;
   bool res = false;
   Pwm* pwm[2] = {NULL, NULL};
+  Pwm::Group* group = NULL;
   Adc* adc = NULL;  
   // The CPU is being clocked by 30 MHz oscillator
   const int32 oscclk = 30000000;
@@ -176,7 +178,9 @@ int _main()
   pwm[1] = Pwm::create(sysclk, 2, Pwm::UP);
   // Create ACD ADCINA0 channel resource and desire setting ADCCLK 25 MHz
   adc = Adc::create(25000000, Adc::SIMULTANEOUS_CASCADED);
-  if(pwm[0] != NULL && pwm[1] != NULL && adc != NULL)
+  // Create a group of the PWMs for updating them in the same period
+  if(pwm[0] != NULL && pwm[1] != NULL) group = Pwm::Group::create(pwm, 2);
+  if(group != NULL && adc != NULL)
   {
     res = true;    
     // Enable phase synchronization for accessing the synchronize method
@@ -190,12 +194,12 @@ int _main()
     res &= pwm[0]->isDeadBanded();    
     res &= pwm[1]->isDeadBanded();
     // Set new task for PWM 1 (A and B channels) at 42 KHz
-    res &= setPwmTask(*pwm[0], 42000, 50.0f, 50.0f);    
+    res &= setPwmTask(*group, 0, 42000, 50.0f, 50.0f);    
     // Set new task for PWM 2 (C channel) at 200 KHz in HR mode
     pwm[1]->enableHighResolution();          
-    res &= setPwmTask(*pwm[1], 200000, 50.0f, 0.0f);
-    res &= pwm[0]->start();
-    res &= pwm[1]->start();
+    res &= setPwmTask(*group, 1, 200000, 50.0f, 0.0f);
+    // Start both the PWMs in the same period
+    res &= group->commit();
     if(res)
     {
       Pwm::DeadBand* db[2];
@@ -223,6 +227,8 @@ int _main()
   }
   // Delete the ADC resource
   delete adc;  
+  // Delete the PWM group
+  delete group;
   // Delete the PWM resource
   delete pwm[1];  
   // Delete the PWM resource
@@ -25,7 +25,7 @@ const int32 PWM_CHANNELS = 2;
 static bool startPwmTask(Pwm& pwm, int32 frequency, float32 duty0, float32 duty1)
 {
   (void) startPwmTask;
-  Pwm::TaskData<PWM_CHANNELS> data = {frequency, duty0, duty1};
+  Pwm::TaskData<PWM_CHANNELS> data = {frequency, duty0, duty1, 0};
   Pwm::Task<PWM_CHANNELS> task = data;
   if( not pwm.setTask(task) ) return false;  
   return pwm.start();
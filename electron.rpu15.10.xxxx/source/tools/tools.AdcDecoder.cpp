@@ -0,0 +1,74 @@
+/**
+ * Host tool for decoding compressed ADC logs.
+ *
+ * The tool reads a raw binary dump of a log buffer, which contains 16-bit
+ * little-endian words, and prints the decoded samples as comma-separated
+ * values, one line per each group of interleaved signals.
+ *
+ * Build: c++ -I../driver/include tools.AdcDecoder.cpp -o adc-decoder
+ * Usage: adc-decoder <dump file>
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "driver.AdcCompressor.hpp"
+
+/**
+ * Host program entry.
+ *
+ * @param argc the number of arguments.
+ * @param argv the arguments.
+ * @return error code or zero.
+ */
+int main(int argc, char** argv)
+{
+  if(argc != 2)
+  {
+    fprintf(stderr, "Usage: %s <dump file>\n", argv[0]);
+    return 1;
+  }
+  FILE* file = fopen(argv[1], "rb");
+  if(file == NULL)
+  {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  int32 length = static_cast<int32>(size / 2);
+  unsigned char* bytes = static_cast<unsigned char*>(malloc(size + 1));
+  uint16* buffer = static_cast<uint16*>(malloc((length + 1) * sizeof(uint16)));
+  if(bytes == NULL || buffer == NULL || fread(bytes, 1, size, file) != static_cast<size_t>(size))
+  {
+    fprintf(stderr, "Cannot read %s\n", argv[1]);
+    fclose(file);
+    return 1;
+  }
+  fclose(file);
+  // Assemble words of the target byte order
+  for(int32 i=0; i<length; i++)
+    buffer[i] = static_cast<uint16>(bytes[2 * i] | bytes[2 * i + 1] << 8);
+  AdcDecompressor log(buffer, length);
+  if( not log.isConstructed() )
+  {
+    fprintf(stderr, "The dump is not a compressed ADC log\n");
+    return 1;
+  }
+  int32 lanes = log.getLanesNumber();
+  int32 samples = log.getSamplesNumber();
+  for(int32 i=0; i<samples; i++)
+  {
+    int32 sample = log.read();
+    if(sample == AdcDecompressor::ERROR)
+    {
+      fprintf(stderr, "The log is corrupted at sample %ld\n", static_cast<long>(i));
+      return 1;
+    }
+    printf(i % lanes == lanes - 1 ? "%ld\n" : "%ld,", static_cast<long>(sample));
+  }
+  free(buffer);
+  free(bytes);
+  return 0;
+}
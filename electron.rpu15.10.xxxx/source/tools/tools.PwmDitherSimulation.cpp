@@ -0,0 +1,148 @@
+/**
+ * Host simulation of the spread-spectrum PWM dither.
+ *
+ * The simulation builds one sequence of the dithered periods of the up-count mode
+ * with the same period and compare values as the dither of the PWM driver writes,
+ * and calculates the line spectrum of the wave, which is periodic with the sequence.
+ * The peak of each odd harmonic band is compared with the harmonic of the wave
+ * without the dither, and the reduction is printed in dB. The line resolution
+ * is the carrier frequency divided by the sequence length.
+ *
+ * Build: c++ -I../driver/include tools.PwmDitherSimulation.cpp -o pwm-dither-simulation
+ * Usage: pwm-dither-simulation [band in % [length [triangle|random [period in clocks [duty in %]]]]]
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "driver.PwmDitherSequence.hpp"
+
+/**
+ * Max simulated harmonic.
+ */
+static const int HARMONICS = 9;
+
+/**
+ * Returns the amplitude of a spectrum line of a pulse train.
+ *
+ * The pulses are high from the beginning of each period for its width,
+ * and the train is repeated with its total time.
+ *
+ * @param period the periods in clocks.
+ * @param width  the pulse widths in clocks.
+ * @param number the number of periods.
+ * @param total  the total time of the periods in clocks.
+ * @param line   the line number, which frequency is line/total.
+ * @return the amplitude normalized to the pulse height.
+ */
+static double amplitude(const long* period, const long* width, int number, long total, long line)
+{
+  const double pi = 3.14159265358979323846;
+  double omega = 2.0 * pi * line / total;
+  double re = 0.0;
+  double im = 0.0;
+  long begin = 0;
+  for(int k=0; k<number; k++)
+  {
+    // The integral of exp(-j*omega*t) over the pulse
+    double t0 = omega * begin;
+    double t1 = omega * (begin + width[k]);
+    re += sin(t1) - sin(t0);
+    im += cos(t1) - cos(t0);
+    begin += period[k];
+  }
+  // The one-sided amplitude of the Fourier series coefficient
+  return 2.0 * sqrt(re * re + im * im) / (omega * total);
+}
+
+/**
+ * Fills the periods and widths of a sequence.
+ *
+ * @param seq    the dither sequence, or null for no dither.
+ * @param scale  the nominal period in clocks.
+ * @param duty   the duty in Q15 format.
+ * @param period the periods to be filled.
+ * @param width  the pulse widths to be filled.
+ * @param number the number of periods.
+ * @return the total time of the periods in clocks.
+ */
+static long fill(PwmDitherSequence* seq, long scale, uint16 duty, long* period, long* width, int number)
+{
+  long total = 0;
+  for(int k=0; k<number; k++)
+  {
+    long offset = seq == NULL ? 0 : seq->next();
+    period[k] = scale + offset;
+    // The up-count mode sets the output on zero and clears it after the compare, which base is minus one
+    width[k] = PwmDitherSequence::getCompare(static_cast<uint32>(period[k]), duty, -1, 0) + 1;
+    total += period[k];
+  }
+  return total;
+}
+
+/**
+ * Host program entry.
+ *
+ * @param argc the number of arguments.
+ * @param argv the arguments.
+ * @return error code or zero.
+ */
+int main(int argc, char** argv)
+{
+  // The default carrier is 100 kHz of the 150 MHz time-base clock
+  double band = argc > 1 ? atof(argv[1]) : 5.0;
+  int length = argc > 2 ? atoi(argv[2]) : 256;
+  bool random = argc > 3 && strcmp(argv[3], "random") == 0;
+  long scale = argc > 4 ? atol(argv[4]) : 1500;
+  double percent = argc > 5 ? atof(argv[5]) : 50.0;
+  if(band <= 0.0 || band >= 100.0 || length < 2 || scale < 4 || percent < 0.0 || percent > 100.0)
+  {
+    fprintf(stderr, "Usage: %s [band in %% [length [triangle|random [period in clocks [duty in %%]]]]]\n", argv[0]);
+    return 1;
+  }
+  // The same scaling as the dither does
+  int32 dev = static_cast<int32>( static_cast<float32>(scale) * static_cast<float32>(band) / 100.0f );
+  uint16 duty = percent >= 100.0 ? 0x8000 : static_cast<uint16>(static_cast<float32>(percent) * 327.68f);
+  if(dev < 1)
+  {
+    fprintf(stderr, "The band is less than one clock\n");
+    return 1;
+  }
+  long* period = static_cast<long*>(malloc(length * sizeof(long)));
+  long* width = static_cast<long*>(malloc(length * sizeof(long)));
+  if(period == NULL || width == NULL) return 1;
+  PwmDitherSequence seq(dev, length, random);
+  long ref, pulse;
+  long nominal = fill(NULL, scale, duty, &ref, &pulse, 1);
+  long total = fill(&seq, scale, duty, period, width, length);
+  printf("Period %ld clocks, deviation %ld clocks, %d periods of %s sequence\n",
+    scale, static_cast<long>(dev), length, random ? "random" : "triangle");
+  printf("Mean period %.3f clocks\n", static_cast<double>(total) / length);
+  printf("harmonic,no dither,dither,reduction dB\n");
+  double worst = 0.0;
+  double peak = 0.0;
+  for(int h=1; h<=HARMONICS; h++)
+  {
+    double line = amplitude(&ref, &pulse, 1, nominal, h);
+    if(line < 1e-6) continue;
+    // The band of the harmonic is from the half of the carrier below to the half above
+    long first = static_cast<long>( (h - 0.5) * total / nominal );
+    long last = static_cast<long>( (h + 0.5) * total / nominal );
+    double max = 0.0;
+    for(long l=first < 1 ? 1 : first; l<=last; l++)
+    {
+      double value = amplitude(period, width, length, total, l);
+      if(value > max) max = value;
+    }
+    double reduction = 20.0 * log10(line / max);
+    printf("%d,%.6f,%.6f,%.2f\n", h, line, max, reduction);
+    if(line > worst) worst = line;
+    if(max > peak) peak = max;
+  }
+  printf("Spectrum peak reduction %.2f dB\n", 20.0 * log10(worst / peak));
+  free(width);
+  free(period);
+  return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * Host test of the three-phase space vector modulation.
+ *
+ * The test sweeps a voltage reference over all six sectors in the linear and 
+ * over-modulation ranges, and compares the duties of the modulation with 
+ * a reference model of the min-max zero sequence injection, where an 
+ * over-modulated reference is scaled to the hexagon boundary.
+ *
+ * Build: c++ -I../driver/include tools.PwmVectorTest.cpp -o pwm-vector-test
+ * Usage: pwm-vector-test
+ *
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ */
+#include <stdio.h>
+#include <math.h>
+#include "driver.PwmVectorModulation.hpp"
+
+/**
+ * Max deviation of a duty from the reference model in Q15 steps.
+ */
+static const double TOLERANCE = 2.0;
+
+/**
+ * Number of the reference angles in one output wave period.
+ */
+static const int ANGLES = 3600;
+
+/**
+ * Calculates the reference duties and sector.
+ *
+ * @param magnitude a magnitude normalized to the DC link voltage.
+ * @param angle     an angle from the phase A axis in radians.
+ * @param duty      an array of the duties from 0.0 to 1.0 to be filled.
+ * @return the sector from 1 to 6.
+ */
+static int reference(double magnitude, double angle, double* duty)
+{
+  const double pi = 3.14159265358979323846;
+  double volt[PwmVectorModulation::PHASES_NUMBER];
+  double max = -2.0;
+  double min = 2.0;
+  for(int i=0; i<PwmVectorModulation::PHASES_NUMBER; i++)
+  {
+    volt[i] = magnitude * cos(angle - 2.0 * pi * i / 3.0);
+    if(volt[i] > max) max = volt[i];
+    if(volt[i] < min) min = volt[i];
+  }
+  // The reference out of the hexagon is scaled to its boundary
+  double scale = max - min > 1.0 ? 1.0 / (max - min) : 1.0;
+  for(int i=0; i<PwmVectorModulation::PHASES_NUMBER; i++)
+    duty[i] = 0.5 + scale * (volt[i] - 0.5 * (max + min));
+  return static_cast<int>(angle / (pi / 3.0)) + 1;
+}
+
+/**
+ * Host program entry.
+ *
+ * @return error code or zero.
+ */
+int main()
+{
+  const double pi = 3.14159265358979323846;
+  // The linear range ends at 1/sqrt(3), and the six-step operation is at 2/3
+  const double magnitudes[] = {0.0, 0.1, 0.3, 0.5, 0.57735, 0.6, 0.66667, 0.8, 1.0};
+  const int number = sizeof(magnitudes) / sizeof(magnitudes[0]);
+  int tests = 0;
+  int errors = 0;
+  double deviation = 0.0;
+  for(int m=0; m<number; m++)
+  {
+    for(int a=0; a<ANGLES; a++)
+    {
+      // Shift the angles from the sector boundaries, where the sector is ambiguous
+      double angle = 2.0 * pi * (a + 0.5) / ANGLES;
+      double magnitude = magnitudes[m];
+      double duty[PwmVectorModulation::PHASES_NUMBER];
+      int sector = reference(magnitude, angle, duty);
+      uint16 value[PwmVectorModulation::PHASES_NUMBER];
+      int32 res = PwmVectorModulation::modulate( static_cast<float32>(magnitude * cos(angle)), 
+                                                 static_cast<float32>(magnitude * sin(angle)), value );
+      bool error = magnitude > 0.0 && res != sector;
+      for(int i=0; i<PwmVectorModulation::PHASES_NUMBER; i++)
+      {
+        double dev = fabs(value[i] - duty[i] * 32768.0);
+        if(dev > deviation) deviation = dev;
+        if(dev > TOLERANCE) error = true;
+      }
+      if(error)
+      {
+        if(errors < 10)
+        {
+          printf("Mismatch at magnitude %f angle %f: sector %ld/%d duties %u,%u,%u/%.1f,%.1f,%.1f\n", 
+            magnitude, angle, static_cast<long>(res), sector, 
+            static_cast<unsigned>(value[0]), static_cast<unsigned>(value[1]), static_cast<unsigned>(value[2]),
+            duty[0] * 32768.0, duty[1] * 32768.0, duty[2] * 32768.0);
+        }
+        errors++;
+      }
+      tests++;
+    }
+  }
+  printf("%d of %d references passed, max duty deviation is %.2f Q15 steps\n", tests - errors, tests, deviation);
+  return errors == 0 ? 0 : 1;
+}